@@ -0,0 +1,74 @@
+/*
+ * Benchmark.cpp
+ *
+ * Firmware for Benchmark.py. BENCHMARK_<name> selects the call, which is measured.
+ * The marker pin is HIGH during the call, so the cycles per call can be taken from the VCD trace of simavr.
+ * Benchmark.py takes the names from the #if lines below, BENCHMARK_NONE is the baseline for flash and RAM.
+ *
+ *  This file is part of TinySerialOut https://github.com/ArminJo/ATtinySerialOut.
+ */
+#include <Arduino.h>
+#include <avr/eeprom.h>
+#include <avr/sleep.h>
+
+#include "ATtinySerialOut.hpp"
+
+// volatile, to avoid that the compiler computes the output at compile time
+volatile uint8_t sByte = 0xA5;
+volatile uint16_t sWord = 65535;
+volatile uint32_t sLong = 4294967295UL;
+volatile int32_t sFixed = -12345;
+volatile float sFloat = 3.14159;
+char sString[] = "Hello World 0123456789";
+const char sStringP[] PROGMEM = "Hello World 0123456789";
+const char sStringE[] EEMEM = "Hello World 0123456789";
+
+int main() {
+    initTXPin();
+    BENCHMARK_MARKER_DDR |= _BV(BENCHMARK_MARKER_BIT);
+    sei(); // for TINY_SERIAL_USE_TX_BUFFER
+
+    BENCHMARK_MARKER_PORT |= _BV(BENCHMARK_MARKER_BIT); // 2 cycles, subtracted by Benchmark.py
+#if defined(BENCHMARK_NONE)
+#elif defined(BENCHMARK_writeBinary)
+    writeBinary(sByte);
+#elif defined(BENCHMARK_writeString)
+    writeString(sString);
+#elif defined(BENCHMARK_writeString_F)
+    writeString(F("Hello World 0123456789"));
+#elif defined(BENCHMARK_writeString_P)
+    writeString_P(sStringP);
+#elif defined(BENCHMARK_writeString_E)
+    writeString_E(sStringE);
+#elif defined(BENCHMARK_writeBuffer)
+    writeBuffer((const uint8_t*) sString, sizeof(sString) - 1);
+#elif defined(BENCHMARK_print_uint8_t)
+    Serial.print((uint8_t) sByte);
+#elif defined(BENCHMARK_print_uint16_t)
+    Serial.print((uint16_t) sWord);
+#elif defined(BENCHMARK_print_uint32_t)
+    Serial.print((uint32_t) sLong);
+#elif defined(BENCHMARK_printHex_uint16_t)
+    Serial.printHex((uint16_t) sWord);
+#elif defined(BENCHMARK_writeUnsignedWithBase_16)
+    writeUnsignedWithBase(sLong, 16);
+#elif defined(BENCHMARK_printFixed)
+    Serial.printFixed(sFixed, 3);
+#elif defined(BENCHMARK_writeFloat)
+    writeFloat(sFloat);
+#elif defined(BENCHMARK_TINY_PRINTLN)
+    TINY_PRINTLN("W=%u L=%lu", (uint16_t) sWord, (uint32_t) sLong);
+#elif defined(BENCHMARK_TINY_LOG)
+    TINY_LOG("W=%u L=%lu", (uint16_t) sWord, (uint32_t) sLong);
+#endif
+    BENCHMARK_MARKER_PORT &= ~_BV(BENCHMARK_MARKER_BIT);
+
+#if defined(TINY_SERIAL_USE_TX_BUFFER)
+    flushTXBuffer();
+#endif
+    // simavr stops at sleep with interrupts disabled
+    cli();
+    sleep_enable();
+    sleep_cpu();
+    return 0;
+}
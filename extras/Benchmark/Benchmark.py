@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+#
+# Benchmark.py
+#
+# Measures the output functions of the ATtinySerialOut library with avr-gcc and the simavr AVR simulator.
+# For each combination of MCU, F_CPU, baud rate, kernel option and function, Benchmark.cpp is compiled with one call
+# of the function and run by simavr. The result table contains for each call
+#  - the cycles of the call, from the VCD trace of a marker pin, which is HIGH during the call,
+#  - the bytes sent and the effective bytes per second from the start of the call to the end of the last stop bit,
+#  - the flash and RAM size compared to Benchmark.cpp without a call (BENCHMARK_NONE).
+# For TINY_SERIAL_USE_TX_BUFFER the cycles are the time until the call returns, which is much less than the time on the wire.
+# The output is CSV or JSON, so results before and after a change of the library can be compared by a script or spreadsheet.
+# Combinations rejected by the library with #error or static_assert are left empty. Other compile errors and simavr timeouts
+# are printed to stderr and give exit code 1.
+#
+# Requires avr-gcc, avr-libc and simavr with its headers, like extras/TimingCheck/TimingCheck.py.
+#
+# Usage:
+#   python3 Benchmark.py > Benchmark.csv                  # all functions for ATtiny85 at 1, 8 and 16 MHz
+#   python3 Benchmark.py --mcu attiny85 --fcpu 8000000 --function writeString --function writeString_F --format json
+#
+#  Copyright (C) 2024  Armin Joachimsmeyer
+#  Email: armin.joachimsmeyer@gmail.com
+#
+#  This file is part of TinySerialOut https://github.com/ArminJo/ATtinySerialOut.
+#
+#  TinySerialOut is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#  See the GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/gpl.html>.
+#
+
+import argparse
+import concurrent.futures
+import csv
+import itertools
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+BENCHMARK_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
+TIMING_CHECK_DIRECTORY = os.path.join(BENCHMARK_DIRECTORY, '..', 'TimingCheck')
+SOURCE_DIRECTORY = os.path.join(BENCHMARK_DIRECTORY, '..', '..', 'src')
+sys.path.insert(0, TIMING_CHECK_DIRECTORY)
+from TimingCheck import MCUS, OPTIONS, readVCD  # noqa: E402
+
+# simavr name: (marker port, DDR, bit), must not be the TX pin of TimingCheck.MCUS
+MARKERS = {
+    'attiny13': ('PORTB', 'DDRB', 0),
+    'attiny85': ('PORTB', 'DDRB', 0),
+    'attiny84': ('PORTA', 'DDRA', 0),
+    'attiny88': ('PORTD', 'DDRD', 5),
+}
+DEFAULT_BAUDRATE = 115200
+MARKER_CYCLES = 2  # for the sbi of the marker
+FIELDS = ('mcu', 'f_cpu', 'baudrate', 'option', 'function', 'cycles', 'bytes', 'bytes_per_second', 'flash', 'ram')
+
+
+def getFunctions():
+    with open(os.path.join(BENCHMARK_DIRECTORY, 'Benchmark.cpp')) as tFile:
+        return [tName for tName in re.findall(r'^#(?:el)?if defined\(BENCHMARK_(\w+)\)', tFile.read(), re.MULTILINE) if tName != 'NONE']
+
+
+def getSizes(aArguments, aElf):
+    """ Returns flash and RAM size like avr-size """
+    tOutput = subprocess.run([aArguments.gcc_prefix + 'size', '-A', aElf], capture_output=True, text=True, check=True).stdout
+    tSections = {tMatch.group(1): int(tMatch.group(2)) for tMatch in re.finditer(r'^(\.\w+)\s+(\d+)', tOutput, re.MULTILINE)}
+    return (tSections.get('.text', 0) + tSections.get('.data', 0),
+            tSections.get('.data', 0) + tSections.get('.bss', 0) + tSections.get('.noinit', 0))
+
+
+def build(aArguments, aDirectory, aMCU, aFCPU, aBaudrate, aOption, aFunction):
+    """ Returns the ELF file name or raises CalledProcessError """
+    tGCCMCU, tTXPin, tPort, tBit, _ = MCUS[aMCU]
+    tMarkerPort, tMarkerDDR, tMarkerBit = MARKERS[aMCU]
+    tDefines = ['-DF_CPU=%dUL' % aFCPU, '-DTX_PIN=' + tTXPin, '-DBENCHMARK_' + aFunction, '-DBENCHMARK_MARKER_PORT=' + tMarkerPort,
+                '-DBENCHMARK_MARKER_DDR=' + tMarkerDDR, '-DBENCHMARK_MARKER_BIT=%d' % tMarkerBit]
+    tDefines += ['-DTINY_SERIAL_BAUDRATE=%d' % aBaudrate, '-DTINY_SERIAL_TX_BUFFER_BAUDRATE=%d' % aBaudrate]
+    if aOption:
+        tDefines += ['-D' + tMacro for tMacro in aOption.split('+')]
+    tCommon = [aArguments.gcc_prefix + 'gcc', '-mmcu=' + tGCCMCU, '-Os', '-ffunction-sections', '-fdata-sections', '-c'] + tDefines
+    tElf = os.path.join(aDirectory, aFunction + '.elf')
+    tObjects = [os.path.join(aDirectory, aFunction + '.o'), os.path.join(aDirectory, aFunction + 'Trace.o')]
+    for tCommand in (
+            tCommon + ['-x', 'c++', '-std=gnu++11', '-I' + TIMING_CHECK_DIRECTORY, '-I' + SOURCE_DIRECTORY,
+                       os.path.join(BENCHMARK_DIRECTORY, 'Benchmark.cpp'), '-o', tObjects[0]],
+            tCommon + ['-I' + aArguments.simavr_include, '-DTIMING_CHECK_MCU="%s"' % aMCU, '-DTIMING_CHECK_PORT=' + tPort,
+                       '-DTIMING_CHECK_BIT=%d' % tBit, os.path.join(BENCHMARK_DIRECTORY, 'BenchmarkTrace.c'), '-o', tObjects[1]],
+            [aArguments.gcc_prefix + 'gcc', '-mmcu=' + tGCCMCU, '-Wl,--gc-sections', '-Wl,--undefined=_mmcu,--section-start=.mmcu=0x910000']
+            + tObjects + ['-o', tElf]):
+        subprocess.run(tCommand, capture_output=True, text=True, check=True)
+    return tElf
+
+
+def isNotSupported(aError):
+    """ The library rejects unsupported combinations with #error or static_assert, like in TimingCheck.py """
+    return '#error' in aError.stderr or 'static assertion failed' in aError.stderr
+
+
+def measure(aRow, aVCD, aFCPU, aBaudrate):
+    tMarker = [(round(tTime * aFCPU), tLevel) for tTime, tLevel in readVCD(aVCD, 'MARKER')]
+    tTX = [(round(tTime * aFCPU), tLevel) for tTime, tLevel in readVCD(aVCD, 'TX')]
+    tStart = next(tTime for tTime, tLevel in tMarker if tLevel)
+    tEnd = next(tTime for tTime, tLevel in tMarker if not tLevel and tTime > tStart)
+    aRow['cycles'] = tEnd - tStart - MARKER_CYCLES
+
+    # Count frames, a falling edge after the end of the previous frame is a start bit
+    tCyclesPerBit = aFCPU / aBaudrate
+    tFrameEnd = 0
+    tBytes = 0
+    for tTime, tLevel in tTX:
+        if not tLevel and tTime >= tFrameEnd and tTime >= tStart:
+            tBytes += 1
+            tFrameEnd = tTime + 9.5 * tCyclesPerBit
+    aRow['bytes'] = tBytes
+    if tBytes > 0:
+        tWireEnd = tFrameEnd + 0.5 * tCyclesPerBit
+        aRow['bytes_per_second'] = round(tBytes * aFCPU / (max(tWireEnd, tEnd) - tStart))
+
+
+def runCombination(aArguments, aMCU, aFCPU, aBaudrate, aOption):
+    """ Returns the rows and the number of failures """
+    tRows = []
+    tFailures = 0
+    tDirectory = tempfile.mkdtemp(prefix='Benchmark')
+    try:
+        try:
+            tBaseElf = build(aArguments, tDirectory, aMCU, aFCPU, aBaudrate, aOption, 'NONE')
+        except subprocess.CalledProcessError as tError:
+            if isNotSupported(tError):
+                return tRows, tFailures
+            print('Compile error for %s %d %d %s:\n%s' % (aMCU, aFCPU, aBaudrate, aOption, tError.stderr), file=sys.stderr)
+            return tRows, 1
+        tBaseFlash, tBaseRAM = getSizes(aArguments, tBaseElf)
+        for tFunction in aArguments.function:
+            tRow = dict.fromkeys(FIELDS, '')
+            tRow.update(mcu=aMCU, f_cpu=aFCPU, baudrate=aBaudrate, option=aOption if aOption else 'default', function=tFunction)
+            tRows.append(tRow)
+            try:
+                tElf = build(aArguments, tDirectory, aMCU, aFCPU, aBaudrate, aOption, tFunction)
+            except subprocess.CalledProcessError as tError:
+                if not isNotSupported(tError):
+                    print('Compile error for %s %d %d %s %s:\n%s' % (aMCU, aFCPU, aBaudrate, aOption, tFunction, tError.stderr),
+                          file=sys.stderr)
+                    tFailures += 1
+                continue
+            tFlash, tRAM = getSizes(aArguments, tElf)
+            tRow['flash'] = tFlash - tBaseFlash
+            tRow['ram'] = tRAM - tBaseRAM
+            tRunDirectory = os.path.join(tDirectory, tFunction)
+            os.mkdir(tRunDirectory)
+            try:
+                subprocess.run([aArguments.simavr, tElf], cwd=tRunDirectory, capture_output=True, timeout=60)
+            except subprocess.TimeoutExpired:
+                print('simavr timeout for %s %d %d %s %s' % (aMCU, aFCPU, aBaudrate, aOption, tFunction), file=sys.stderr)
+                tFailures += 1
+                continue
+            tVCD = os.path.join(tRunDirectory, 'Benchmark.vcd')
+            if os.path.exists(tVCD):
+                measure(tRow, tVCD, aFCPU, aBaudrate)
+    finally:
+        shutil.rmtree(tDirectory, ignore_errors=True)
+    return tRows, tFailures
+
+
+def main():
+    tFunctions = getFunctions()
+    tParser = argparse.ArgumentParser(description='Cycles, throughput and flash benchmark of ATtinySerialOut with simavr')
+    tParser.add_argument('--mcu', action='append', choices=sorted(MCUS), help='MCU to measure, can be repeated, default is attiny85')
+    tParser.add_argument('--fcpu', action='append', type=int, help='F_CPU to measure, can be repeated, default are the typical values of each MCU')
+    tParser.add_argument('--baud', action='append', type=int, help='Baud rate to measure, can be repeated, default is %d' % DEFAULT_BAUDRATE)
+    tParser.add_argument('--option', action='append', choices=[tOption for tOption in OPTIONS if tOption] + ['default'],
+                         help='Kernel option to measure, can be repeated, default is all')
+    tParser.add_argument('--function', action='append', choices=tFunctions, help='Function to measure, can be repeated, default is all')
+    tParser.add_argument('--format', choices=('csv', 'json'), default='csv', help='Output format, default is csv')
+    tParser.add_argument('--gcc-prefix', default='avr-', help='Prefix of the compiler, default is avr-')
+    tParser.add_argument('--simavr', default='simavr', help='simavr executable, default is simavr')
+    tParser.add_argument('--simavr-include', default='/usr/include/simavr/avr', help='Directory of avr_mcu_section.h')
+    tParser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='Number of parallel runs')
+    tArguments = tParser.parse_args()
+    if not tArguments.function:
+        tArguments.function = tFunctions
+
+    for tTool in (tArguments.gcc_prefix + 'gcc', tArguments.gcc_prefix + 'size', tArguments.simavr):
+        if shutil.which(tTool) is None:
+            sys.exit('Error: %s not found, see the requirements in the header of this file' % tTool)
+    if not os.path.exists(os.path.join(tArguments.simavr_include, 'avr_mcu_section.h')):
+        sys.exit('Error: avr_mcu_section.h not found in %s, use --simavr-include' % tArguments.simavr_include)
+
+    tOptions = [('' if tOption == 'default' else tOption) for tOption in tArguments.option] if tArguments.option else OPTIONS
+    tCombinations = []
+    for tMCU in (tArguments.mcu if tArguments.mcu else ['attiny85']):
+        tFCPUs = tArguments.fcpu if tArguments.fcpu else MCUS[tMCU][4]
+        tBaudrates = tArguments.baud if tArguments.baud else [DEFAULT_BAUDRATE]
+        tCombinations += [(tMCU,) + tCombination for tCombination in itertools.product(tFCPUs, tBaudrates, tOptions)]
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=tArguments.jobs) as tExecutor:
+        tResults = list(tExecutor.map(lambda aCombination: runCombination(tArguments, *aCombination), tCombinations))
+    tRows = [tRow for tRows, _ in tResults for tRow in tRows]
+    tFailures = sum(tFailures for _, tFailures in tResults)
+
+    if tArguments.format == 'json':
+        json.dump(tRows, sys.stdout, indent=1)
+        print()
+    else:
+        tWriter = csv.DictWriter(sys.stdout, fieldnames=FIELDS)
+        tWriter.writeheader()
+        tWriter.writerows(tRows)
+    if tFailures > 0:
+        sys.exit('Error: %d builds or runs failed, see above' % tFailures)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,18 @@
+/*
+ * BenchmarkTrace.c
+ *
+ * simavr reads the MCU, F_CPU and the VCD traces of the TX and marker pin from the .mmcu section of the ELF file.
+ * The macros are set by Benchmark.py.
+ *
+ *  This file is part of TinySerialOut https://github.com/ArminJo/ATtinySerialOut.
+ */
+#include <avr/io.h>
+#include "avr_mcu_section.h"
+
+AVR_MCU(F_CPU, TIMING_CHECK_MCU);
+AVR_MCU_VCD_FILE("Benchmark.vcd", 1000);
+
+const struct avr_mmcu_vcd_trace_t sTraces[] _MMCU_ = {
+    { AVR_MCU_VCD_SYMBOL("TX"), .mask = (1 << TIMING_CHECK_BIT), .what = (void*) &TIMING_CHECK_PORT, },
+    { AVR_MCU_VCD_SYMBOL("MARKER"), .mask = (1 << BENCHMARK_MARKER_BIT), .what = (void*) &BENCHMARK_MARKER_PORT, },
+};
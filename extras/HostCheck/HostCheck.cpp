@@ -0,0 +1,199 @@
+/*
+ * HostCheck.cpp
+ *
+ * Checks the formatting functions of ATtinySerialOut on the host with random values against snprintf() and measures their host runtime.
+ * Uses the virtual TX line of TINY_SERIAL_HOST_TX. Exit code is 1, if an output differs.
+ *
+ * Build and run from the repository root with:
+ *   g++ -std=gnu++11 -O1 -g -fsanitize=address,undefined -DTINY_SERIAL_HOST_TX -Isrc extras/HostCheck/HostCheck.cpp -o HostCheck
+ *   ./HostCheck [number of random values, default 100000]
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  Email: armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of TinySerialOut https://github.com/ArminJo/ATtinySerialOut.
+ *
+ *  TinySerialOut is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+#include "ATtinySerialOut.hpp"
+
+#include <stdio.h>
+#include <time.h>
+
+uint32_t sRandom = 0x12345678;
+uint32_t sErrorCount = 0;
+
+// xorshift32, so each run checks the same values
+uint32_t nextRandom() {
+    sRandom ^= sRandom << 13;
+    sRandom ^= sRandom >> 17;
+    sRandom ^= sRandom << 5;
+    return sRandom;
+}
+
+// Values with all lengths of digits, not only long ones
+uint32_t nextRandomValue() {
+    return nextRandom() >> (nextRandom() % 32);
+}
+
+/*
+ * Compares the output since the last resetHostTX() with aExpected
+ */
+void check(const char *aName, const char *aExpected) {
+    size_t tLength = strlen(aExpected);
+    if (sHostTXLength != tLength || memcmp(sHostTXBuffer, aExpected, tLength) != 0) {
+        if (sErrorCount < 20) {
+            printf("FAIL %s: expected \"%s\" got \"%.*s\"\n", aName, aExpected, (int) sHostTXLength, (const char*) sHostTXBuffer);
+        }
+        sErrorCount++;
+    }
+    if (sHostTXFrameCount != sHostTXLength) {
+        printf("FAIL %s: virtual TX line buffer is too small\n", aName);
+        sErrorCount++;
+    }
+    resetHostTX();
+}
+
+void checkValue(uint32_t aValue) {
+    char tExpected[80];
+    int32_t tSigned = aValue;
+
+    writeUnsignedLong(aValue);
+    snprintf(tExpected, sizeof(tExpected), "%lu", (unsigned long) aValue);
+    check("writeUnsignedLong", tExpected);
+
+    writeLong(tSigned);
+    snprintf(tExpected, sizeof(tExpected), "%ld", (long) tSigned);
+    check("writeLong", tExpected);
+
+    writeInt((int16_t) aValue);
+    snprintf(tExpected, sizeof(tExpected), "%d", (int16_t) aValue);
+    check("writeInt", tExpected);
+
+    writeUnsignedByte((uint8_t) aValue);
+    snprintf(tExpected, sizeof(tExpected), "%u", (uint8_t) aValue);
+    check("writeUnsignedByte", tExpected);
+
+    // All bases including invalid ones, which print nothing like ultoa()
+    for (uint8_t tBase = 0; tBase <= 40; tBase++) {
+        writeUnsignedWithBase(aValue, tBase);
+        ultoa(aValue, tExpected, tBase);
+        check("writeUnsignedWithBase", tExpected);
+        Serial.print(tSigned, tBase);
+        if (tBase == 10) {
+            snprintf(tExpected, sizeof(tExpected), "%ld", (long) tSigned);
+        }
+        check("print(int32_t, base)", tExpected);
+    }
+
+    Serial.print((uint8_t) aValue, 16);
+    snprintf(tExpected, sizeof(tExpected), "%02x", (uint8_t) aValue);
+    check("print(uint8_t, 16)", tExpected);
+
+    Serial.printHex((uint16_t) aValue);
+    snprintf(tExpected, sizeof(tExpected), "0x%04x", (uint16_t) aValue);
+    check("printHex(uint16_t)", tExpected);
+
+    uint8_t tFractionalDigits = aValue % 10;
+    uint32_t tPower = powerOf10(tFractionalDigits);
+    uint32_t tMagnitude = (tSigned < 0) ? 0 - aValue : aValue;
+    Serial.printFixed(tSigned, tFractionalDigits);
+    if (tFractionalDigits == 0) {
+        snprintf(tExpected, sizeof(tExpected), "%s%lu", (tSigned < 0) ? "-" : "", (unsigned long) tMagnitude);
+    } else {
+        snprintf(tExpected, sizeof(tExpected), "%s%lu.%0*lu", (tSigned < 0) ? "-" : "", (unsigned long) (tMagnitude / tPower),
+                tFractionalDigits, (unsigned long) (tMagnitude % tPower));
+    }
+    check("printFixed", tExpected);
+
+    TINY_PRINTF("%hu %lx %hhd", (uint16_t) aValue, aValue, (int8_t) aValue);
+    snprintf(tExpected, sizeof(tExpected), "%u %lx %d", (uint16_t) aValue, (unsigned long) aValue, (int8_t) aValue);
+    check("TINY_PRINTF", tExpected);
+
+    // Plain int has the size of the target
+    int tInt = tSigned;
+    TINY_PRINTF("%d %hu", tInt, (uint16_t) aValue);
+    snprintf(tExpected, sizeof(tExpected), "%d %u", tInt, (uint16_t) aValue);
+    check("TINY_PRINTF(int)", tExpected);
+
+    // The float digits of writeFloat() may differ in the last digit from the exact value
+    float tFloat = (float) tSigned / (float) (nextRandom() | 1);
+    uint8_t tDigits = aValue % 7;
+    writeFloat(tFloat, tDigits);
+    sHostTXBuffer[sHostTXLength < TINY_SERIAL_HOST_TX_BUFFER_SIZE ? sHostTXLength : TINY_SERIAL_HOST_TX_BUFFER_SIZE - 1] = '\0';
+    double tParsed = strtod((const char*) sHostTXBuffer, NULL);
+    if (fabs(tParsed - tFloat) > 1.01 / powerOf10(tDigits) + fabs(tFloat) * 1e-6) {
+        snprintf(tExpected, sizeof(tExpected), "%.*f", tDigits, tFloat);
+        check("writeFloat", tExpected);
+    }
+    resetHostTX();
+}
+
+/*
+ * Host nanoseconds and modeled wire cycles per call
+ */
+#define BENCHMARK_CALLS 100000
+#define BENCHMARK(aName, aCall) do { \
+    resetHostTX(); \
+    clock_t tStart = clock(); \
+    for (uint32_t i = 0; i < BENCHMARK_CALLS; i++) { \
+        uint32_t tValue = i * 2654435761UL; \
+        (void) tValue; \
+        aCall; \
+        sHostTXLength = 0; \
+    } \
+    double tNanoseconds = (double) (clock() - tStart) * 1e9 / CLOCKS_PER_SEC / BENCHMARK_CALLS; \
+    printf("%-28s %8.1f ns %8.1f bytes %10.1f cycles on the wire\n", aName, tNanoseconds, \
+            (double) sHostTXFrameCount / BENCHMARK_CALLS, (double) sHostTXCycles / BENCHMARK_CALLS); \
+    } while (0)
+
+int main(int argc, char *argv[]) {
+    uint32_t tCount = (argc > 1) ? strtoul(argv[1], NULL, 0) : 100000;
+    initTXPin();
+    resetHostTX();
+
+    checkValue(0);
+    checkValue(0xFFFFFFFF);
+    checkValue(0x80000000);
+    for (uint32_t i = 0; i < tCount; i++) {
+        checkValue(nextRandomValue());
+    }
+
+    // Log levels above the default TINY_LOG_LEVEL_INFO and disabled channels print nothing
+    TINY_INFO(0x01, "Value=%u", 42);
+    TINY_DEBUG(0x01, "Value=%u", 42);
+    sTinyLogChannels = 0x02;
+    TINY_ERROR(0x01, "Value=%u", 42);
+    sTinyLogChannels = 0xFF;
+    check("TINY_INFO", "I Value=42\r\n");
+    TINY_PRINTLN("100%% done");
+    check("TINY_PRINTLN without arguments", "100% done\r\n");
+    // %E and %G are floats like in TinyLogDecoder.py, %c has always 1 byte
+    TINY_PRINTLN("%.1E %G %hc", 2.5f, -1.25, 'x');
+    check("TINY_PRINTLN(%E %G %c)", "2.5 -1.25 x\r\n");
+    printf("%lu values checked, %lu errors\n", (unsigned long) tCount + 4, (unsigned long) sErrorCount);
+
+    printf("F_CPU=%lu baud rate=%lu\n", (unsigned long) F_CPU, (unsigned long) TINY_SERIAL_BAUDRATE);
+    BENCHMARK("writeUnsignedLong", writeUnsignedLong(tValue));
+    BENCHMARK("writeLong", writeLong(tValue));
+    BENCHMARK("writeUnsignedWithBase(16)", writeUnsignedWithBase(tValue, 16));
+    BENCHMARK("printHex(uint16_t)", Serial.printHex((uint16_t) tValue));
+    BENCHMARK("printFixed(3)", Serial.printFixed(tValue, 3));
+    BENCHMARK("writeFloat(3)", writeFloat(tValue / 1000.0, 3));
+    BENCHMARK("writeString(F())", writeString(F("Hello World")));
+    BENCHMARK("TINY_PRINTLN", TINY_PRINTLN("V=%lu", tValue));
+
+    return (sErrorCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,29 @@
+/*
+ * Arduino.h
+ *
+ * Minimal replacement of the Arduino core header for TimingCheck.
+ * The library only requires the AVR headers and the ATTinyCore pin numbers of the TX pin.
+ *
+ *  This file is part of TinySerialOut https://github.com/ArminJo/ATtinySerialOut.
+ */
+#ifndef _TIMING_CHECK_ARDUINO_H
+#define _TIMING_CHECK_ARDUINO_H
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Only the pins used by TimingCheck.py
+#define PIN_PA1 1 // ATtiny84, ATtiny87/167
+#define PIN_PB2 2 // ATtiny13, ATtiny85
+#define PIN_PD6 6 // ATtiny88
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#endif // _TIMING_CHECK_ARDUINO_H
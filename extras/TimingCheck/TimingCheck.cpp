@@ -0,0 +1,44 @@
+/*
+ * TimingCheck.cpp
+ *
+ * Firmware for TimingCheck.py. Sends the test bytes with all output functions and stops the simulation.
+ * The bytes must be the same as TEST_BYTES in TimingCheck.py.
+ *
+ *  This file is part of TinySerialOut https://github.com/ArminJo/ATtinySerialOut.
+ */
+#include <Arduino.h>
+#include <avr/sleep.h>
+
+#include "ATtinySerialOut.hpp"
+
+const uint8_t sTestBuffer[] = { 0x00, 0xFF, 0x55 };
+
+int main() {
+    initTXPin();
+    sei(); // for TINY_SERIAL_USE_TX_BUFFER
+
+    // Single bytes with all bit edges
+    writeBinary(0x55);
+    writeBinary(0xAA);
+    writeBinary(0x00);
+    writeBinary(0xFF);
+    writeBinary(0x01);
+    writeBinary(0x80);
+    writeBinary(0x0F);
+    writeBinary(0xF0);
+
+    // Strings and buffers use the streaming kernels with exactly one stop bit
+    writeString("Hello 0123456789");
+    writeString(F("UUU~~~"));
+    writeBuffer(sTestBuffer, sizeof(sTestBuffer));
+    writeUnsignedLong(4294967295UL);
+
+#if defined(TINY_SERIAL_USE_TX_BUFFER)
+    flushTXBuffer();
+#endif
+    // simavr stops at sleep with interrupts disabled
+    cli();
+    sleep_enable();
+    sleep_cpu();
+    return 0;
+}
@@ -0,0 +1,280 @@
+#!/usr/bin/env python3
+#
+# TimingCheck.py
+#
+# Bit timing regression check of the ATtinySerialOut kernels with the simavr AVR simulator.
+# For each combination of MCU, F_CPU, baud rate and kernel option, TimingCheck.cpp is compiled with avr-gcc and run by simavr,
+# which writes all changes of the TX pin with their time to a VCD file. The frames are decoded and checked for
+#  - the edge error in percent of a bit time, measured from the start bit edge, like a receiver does.
+#    The limit is --tolerance plus half a CPU cycle, since no kernel can place an edge more exactly than one cycle,
+#  - the length of the stop bit and the gap between the frames,
+#  - the received bytes.
+# Combinations rejected by the compile time checks of the library are reported as skipped.
+# Only the software kernels and the timer ISR of TINY_SERIAL_USE_TX_BUFFER write to the PORT register, which is traced.
+# So USI, Timer1 compare output and LIN/UART output are not checked. ATtiny87/167 are not in MCUS and not checked too, see NOT_COVERED.
+#
+# Requires avr-gcc, avr-libc and simavr with its headers, e.g. "sudo apt install gcc-avr avr-libc simavr libsimavr-dev".
+#
+# Usage:
+#   python3 TimingCheck.py                      # all combinations, exit code 1 if one fails
+#   python3 TimingCheck.py --mcu attiny85 --fcpu 1000000 --baud 115200 -v
+#
+#  Copyright (C) 2024  Armin Joachimsmeyer
+#  Email: armin.joachimsmeyer@gmail.com
+#
+#  This file is part of TinySerialOut https://github.com/ArminJo/ATtinySerialOut.
+#
+#  TinySerialOut is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#  See the GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/gpl.html>.
+#
+
+import argparse
+import concurrent.futures
+import itertools
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+CHECK_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
+SOURCE_DIRECTORY = os.path.join(CHECK_DIRECTORY, '..', '..', 'src')
+
+# simavr name: (avr-gcc -mmcu, TX_PIN, traced port, bit, F_CPU values)
+MCUS = {
+    'attiny13': ('attiny13a', 'PIN_PB2', 'PORTB', 2, (1200000, 9600000)),
+    'attiny85': ('attiny85', 'PIN_PB2', 'PORTB', 2, (1000000, 8000000, 16000000)),
+    'attiny84': ('attiny84', 'PIN_PA1', 'PORTA', 1, (1000000, 8000000)),
+    'attiny88': ('attiny88', 'PIN_PD6', 'PORTD', 6, (8000000, 16000000)),
+}
+NOT_COVERED = 'ATtiny87/167, TINY_SERIAL_USE_USI_TX, TINY_SERIAL_USE_TIMER1_OC_TX and TINY_SERIAL_USE_LIN_UART_TX'
+BAUDRATES = (9600, 19200, 38400, 57600, 115200, 230400, 250000, 500000, 1000000, 2000000)
+# Macros of one option are joined by +
+OPTIONS = ('', 'TINY_SERIAL_USE_STREAM_KERNEL', 'TINY_SERIAL_USE_TURBO_KERNEL', 'TINY_SERIAL_USE_TURBO_KERNEL+TINY_SERIAL_USE_STREAM_KERNEL',
+           'TINY_SERIAL_RUNTIME_BAUDRATE', 'TINY_SERIAL_USE_TX_BUFFER')
+
+# Must be the same as in TimingCheck.cpp
+TEST_BYTES = (bytes([0x55, 0xAA, 0x00, 0xFF, 0x01, 0x80, 0x0F, 0xF0]) + b'Hello 0123456789' + b'UUU~~~' + bytes([0x00, 0xFF, 0x55])
+              + b'4294967295')
+
+
+class Result:
+    def __init__(self, aName):
+        self.Name = aName
+        self.Status = 'PASS'
+        self.Message = ''
+        self.MaxEdgeError = 0.0  # percent of a bit time
+        self.EdgeErrorPerBit = [0.0] * 10  # maximum for the edges at the start of bit 1 to 9, index 0 is unused
+        self.MinStopBits = None
+        self.MaxGapBits = None
+
+    def fail(self, aMessage):
+        if self.Status != 'FAIL':
+            self.Status = 'FAIL'
+            self.Message = aMessage
+
+
+def readVCD(aFileName, aSignalName='TX'):
+    """ Returns the list of (time in seconds, level) of a 1 bit signal """
+    tScale = 1e-9
+    tIdentifier = None
+    tTime = 0
+    tEdges = []
+    with open(aFileName) as tFile:
+        tText = tFile.read()
+    tMatch = re.search(r'\$timescale\s+(\d+)\s*(s|ms|us|ns|ps)\s+\$end', tText)
+    if tMatch:
+        tScale = int(tMatch.group(1)) * {'s': 1, 'ms': 1e-3, 'us': 1e-6, 'ns': 1e-9, 'ps': 1e-12}[tMatch.group(2)]
+    tMatch = re.search(r'\$var\s+\S+\s+\d+\s+(\S+)\s+' + aSignalName + r'\s', tText)
+    if not tMatch:
+        raise ValueError('No %s signal in %s' % (aSignalName, aFileName))
+    tIdentifier = tMatch.group(1)
+    for tLine in tText[tText.index('$enddefinitions'):].splitlines()[1:]:
+        tLine = tLine.strip()
+        if tLine.startswith('#'):
+            tTime = int(tLine[1:])
+        elif tLine.startswith('b'):
+            tValue, tId = tLine[1:].split()
+            if tId == tIdentifier:
+                tEdges.append((tTime * tScale, int(tValue.replace('x', '0').replace('z', '0'), 2) != 0))
+        elif tLine[1:] == tIdentifier and tLine[0] in '01xz':
+            tEdges.append((tTime * tScale, tLine[0] == '1'))
+    # Remove entries without level change
+    tChanges = []
+    for tEdge in tEdges:
+        if not tChanges or tChanges[-1][1] != tEdge[1]:
+            tChanges.append(tEdge)
+    return tChanges
+
+
+def levelAt(aEdges, aTime):
+    tLevel = True  # idle
+    for tTime, tNewLevel in aEdges:
+        if tTime > aTime:
+            break
+        tLevel = tNewLevel
+    return tLevel
+
+
+def checkFrames(aResult, aEdges, aFCPU, aBaudrate, aTolerance):
+    """ The cycle times of the kernels are computed for F_CPU, so the times are converted to cycles """
+    tEdges = [(round(tTime * aFCPU), tLevel) for tTime, tLevel in aEdges]
+    tCyclesPerBit = aFCPU / aBaudrate
+    tLimit = aTolerance + 50 / tCyclesPerBit  # half a cycle in percent of a bit time
+    tReceived = bytearray()
+    tIndex = 0
+    while True:
+        # next falling edge is a start bit
+        while tIndex < len(tEdges) and tEdges[tIndex][1]:
+            tIndex += 1
+        if tIndex >= len(tEdges):
+            break
+        tStart = tEdges[tIndex][0]
+        tByte = 0
+        for tBit in range(8):
+            if levelAt(tEdges, tStart + (tBit + 1.5) * tCyclesPerBit):
+                tByte |= 1 << tBit
+        if levelAt(tEdges, tStart + 0.5 * tCyclesPerBit) or not levelAt(tEdges, tStart + 9.5 * tCyclesPerBit):
+            aResult.fail('Framing error in byte %d' % len(tReceived))
+        tReceived.append(tByte)
+        # All edges of the frame must be near a bit boundary
+        tIndex += 1
+        while tIndex < len(tEdges) and tEdges[tIndex][0] < tStart + 9.5 * tCyclesPerBit:
+            tBitTime = (tEdges[tIndex][0] - tStart) / tCyclesPerBit
+            tBit = round(tBitTime)
+            tError = abs(tBitTime - tBit) * 100
+            if 1 <= tBit <= 9:
+                aResult.EdgeErrorPerBit[tBit] = max(aResult.EdgeErrorPerBit[tBit], tError)
+            aResult.MaxEdgeError = max(aResult.MaxEdgeError, tError)
+            tIndex += 1
+        # Stop bit length and gap up to the next start bit
+        tNextStart = None
+        for tTime, tLevel in tEdges[tIndex:]:
+            if not tLevel:
+                tNextStart = tTime
+                break
+        if tNextStart is not None:
+            tStopBits = (tNextStart - tStart) / tCyclesPerBit - 9
+            if aResult.MinStopBits is None or tStopBits < aResult.MinStopBits:
+                aResult.MinStopBits = tStopBits
+            if aResult.MaxGapBits is None or tStopBits - 1 > aResult.MaxGapBits:
+                aResult.MaxGapBits = tStopBits - 1
+
+    if bytes(tReceived) != TEST_BYTES:
+        aResult.fail('Received %s' % bytes(tReceived))
+    if aResult.MaxEdgeError > tLimit:
+        aResult.fail('Edge error %.1f%% > %.1f%%' % (aResult.MaxEdgeError, tLimit))
+    if aResult.MinStopBits is not None and aResult.MinStopBits < 1 - tLimit / 100:
+        aResult.fail('Stop bit %.2f bits too short' % aResult.MinStopBits)
+
+
+def runCombination(aArguments, aMCU, aFCPU, aBaudrate, aOption):
+    tGCCMCU, tTXPin, tPort, tBit, _ = MCUS[aMCU]
+    tResult = Result('%-8s %8d %7d %s' % (aMCU, aFCPU, aBaudrate, aOption if aOption else 'default'))
+    tDirectory = tempfile.mkdtemp(prefix='TimingCheck')
+    try:
+        tElf = os.path.join(tDirectory, 'TimingCheck.elf')
+        tDefines = ['-DF_CPU=%dUL' % aFCPU, '-DTX_PIN=' + tTXPin, '-DTINY_SERIAL_BAUDRATE=%d' % aBaudrate,
+                    '-DTINY_SERIAL_TX_BUFFER_BAUDRATE=%d' % aBaudrate]
+        if aOption:
+            tDefines += ['-D' + tMacro for tMacro in aOption.split('+')]
+        tCommon = [aArguments.gcc_prefix + 'gcc', '-mmcu=' + tGCCMCU, '-Os', '-c'] + tDefines
+        tCommands = [
+            tCommon + ['-x', 'c++', '-std=gnu++11', '-I' + CHECK_DIRECTORY, '-I' + SOURCE_DIRECTORY,
+                       os.path.join(CHECK_DIRECTORY, 'TimingCheck.cpp'), '-o', os.path.join(tDirectory, 'TimingCheck.o')],
+            tCommon + ['-I' + aArguments.simavr_include, '-DTIMING_CHECK_MCU="%s"' % aMCU, '-DTIMING_CHECK_PORT=' + tPort,
+                       '-DTIMING_CHECK_BIT=%d' % tBit, os.path.join(CHECK_DIRECTORY, 'TimingCheckTrace.c'), '-o',
+                       os.path.join(tDirectory, 'TimingCheckTrace.o')],
+            [aArguments.gcc_prefix + 'gcc', '-mmcu=' + tGCCMCU, '-Wl,--undefined=_mmcu,--section-start=.mmcu=0x910000',
+             os.path.join(tDirectory, 'TimingCheck.o'), os.path.join(tDirectory, 'TimingCheckTrace.o'), '-o', tElf]
+        ]
+        for tCommand in tCommands:
+            tProcess = subprocess.run(tCommand, capture_output=True, text=True)
+            if tProcess.returncode != 0:
+                if '#error' in tProcess.stderr or 'static assertion failed' in tProcess.stderr:
+                    tResult.Status = 'SKIP'
+                    tResult.Message = re.sub(r'.*(#error|static assertion failed)\s*', '',
+                                             next(tLine for tLine in tProcess.stderr.splitlines()
+                                                  if '#error' in tLine or 'static assertion failed' in tLine))
+                else:
+                    tResult.fail('Compile error: ' + tProcess.stderr.strip().splitlines()[-1])
+                return tResult
+
+        tProcess = subprocess.run([aArguments.simavr, tElf], cwd=tDirectory, capture_output=True, text=True, timeout=60)
+        tVCD = os.path.join(tDirectory, 'TimingCheck.vcd')
+        if not os.path.exists(tVCD):
+            tResult.fail('simavr wrote no VCD file: ' + tProcess.stderr.strip())
+            return tResult
+        checkFrames(tResult, readVCD(tVCD), aFCPU, aBaudrate, aArguments.tolerance)
+    except subprocess.TimeoutExpired:
+        tResult.fail('simavr timeout')
+    finally:
+        shutil.rmtree(tDirectory, ignore_errors=True)
+    return tResult
+
+
+def main():
+    tParser = argparse.ArgumentParser(description='Bit timing regression check of ATtinySerialOut with simavr')
+    tParser.add_argument('--mcu', action='append', choices=sorted(MCUS), help='MCU to check, can be repeated, default is all')
+    tParser.add_argument('--fcpu', action='append', type=int, help='F_CPU to check, can be repeated, default are the typical values of each MCU')
+    tParser.add_argument('--baud', action='append', type=int, help='Baud rate to check, can be repeated, default is %s' % (BAUDRATES,))
+    tParser.add_argument('--option', action='append', choices=[tOption for tOption in OPTIONS if tOption] + ['default'],
+                         help='Kernel option to check, can be repeated, default is all')
+    tParser.add_argument('--tolerance', type=float, default=2.5,
+                         help='Maximum edge error in percent of a bit time in addition to half a CPU cycle, default is 2.5')
+    tParser.add_argument('--gcc-prefix', default='avr-', help='Prefix of the compiler, default is avr-')
+    tParser.add_argument('--simavr', default='simavr', help='simavr executable, default is simavr')
+    tParser.add_argument('--simavr-include', default='/usr/include/simavr/avr', help='Directory of avr_mcu_section.h')
+    tParser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='Number of parallel runs')
+    tParser.add_argument('-v', '--verbose', action='store_true', help='Print the edge error of each bit and the skipped combinations')
+    tArguments = tParser.parse_args()
+
+    for tTool in (tArguments.gcc_prefix + 'gcc', tArguments.simavr):
+        if shutil.which(tTool) is None:
+            sys.exit('Error: %s not found, see the requirements in the header of this file' % tTool)
+    if not os.path.exists(os.path.join(tArguments.simavr_include, 'avr_mcu_section.h')):
+        sys.exit('Error: avr_mcu_section.h not found in %s, use --simavr-include' % tArguments.simavr_include)
+
+    tOptions = [('' if tOption == 'default' else tOption) for tOption in tArguments.option] if tArguments.option else OPTIONS
+    tCombinations = []
+    for tMCU in (tArguments.mcu if tArguments.mcu else sorted(MCUS)):
+        tFCPUs = tArguments.fcpu if tArguments.fcpu else MCUS[tMCU][4]
+        tBaudrates = tArguments.baud if tArguments.baud else BAUDRATES
+        tCombinations += [(tMCU,) + tCombination for tCombination in itertools.product(tFCPUs, tBaudrates, tOptions)]
+
+    tCounts = {'PASS': 0, 'FAIL': 0, 'SKIP': 0}
+    with concurrent.futures.ThreadPoolExecutor(max_workers=tArguments.jobs) as tExecutor:
+        for tResult in tExecutor.map(lambda aCombination: runCombination(tArguments, *aCombination), tCombinations):
+            tCounts[tResult.Status] += 1
+            if tResult.Status == 'SKIP' and not tArguments.verbose:
+                continue
+            tLine = '%s %s' % (tResult.Status, tResult.Name)
+            if tResult.Status != 'SKIP':
+                tLine += ' edge error=%4.1f%%' % tResult.MaxEdgeError
+                if tResult.MinStopBits is not None:
+                    tLine += ' stop=%.2f bits max gap=%.2f bits' % (tResult.MinStopBits, tResult.MaxGapBits)
+            if tResult.Message:
+                tLine += ' ' + tResult.Message
+            print(tLine)
+            if tArguments.verbose and tResult.Status != 'SKIP':
+                print('     edge error per bit 1 to 9: ' + ' '.join('%4.1f' % tError for tError in tResult.EdgeErrorPerBit[1:]))
+            sys.stdout.flush()
+
+    print('%d passed, %d failed, %d skipped' % (tCounts['PASS'], tCounts['FAIL'], tCounts['SKIP']))
+    print('Not covered: ' + NOT_COVERED)
+    sys.exit(1 if tCounts['FAIL'] else 0)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,17 @@
+/*
+ * TimingCheckTrace.c
+ *
+ * simavr reads the MCU, F_CPU and the VCD trace of the TX pin from the .mmcu section of the ELF file.
+ * TIMING_CHECK_MCU, TIMING_CHECK_PORT and TIMING_CHECK_BIT are set by TimingCheck.py.
+ *
+ *  This file is part of TinySerialOut https://github.com/ArminJo/ATtinySerialOut.
+ */
+#include <avr/io.h>
+#include "avr_mcu_section.h"
+
+AVR_MCU(F_CPU, TIMING_CHECK_MCU);
+AVR_MCU_VCD_FILE("TimingCheck.vcd", 1000);
+
+const struct avr_mmcu_vcd_trace_t sTXTrace[] _MMCU_ = {
+    { AVR_MCU_VCD_SYMBOL("TX"), .mask = (1 << TIMING_CHECK_BIT), .what = (void*) &TIMING_CHECK_PORT, },
+};
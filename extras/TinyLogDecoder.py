@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+#
+# TinyLogDecoder.py
+#
+# Decodes the binary records of TINY_LOG() and of TINY_ERROR() to TINY_TRACE() with TINY_SERIAL_LOG_BINARY of the ATtinySerialOut library.
+# All TINY_LOG() format strings are extracted from the given sources, and their 16 bit IDs are computed like in ATtinySerialOut.h.
+# All other received bytes are copied unchanged to stdout.
+#
+# Usage:
+#   stty -F /dev/ttyUSB0 115200 raw -echo
+#   python3 TinyLogDecoder.py -i /dev/ttyUSB0 examples/OpenWindowAlarm
+#   python3 TinyLogDecoder.py --table MySketch.ino   # print the ID table only
+#
+#  Copyright (C) 2024  Armin Joachimsmeyer
+#  Email: armin.joachimsmeyer@gmail.com
+#
+#  This file is part of TinySerialOut https://github.com/ArminJo/ATtinySerialOut.
+#
+#  TinySerialOut is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#  See the GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/gpl.html>.
+#
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+TINY_LOG_RECORD_START = 0x1E
+
+SOURCE_EXTENSIONS = ('.ino', '.c', '.cpp', '.h', '.hpp')
+# TINY_LOG( followed by one or more adjacent string literals
+LOG_PATTERN = re.compile(r'TINY_LOG\s*\(\s*((?:"(?:[^"\\]|\\.)*"\s*)+)')
+# TINY_ERROR(aChannels, ...) to TINY_TRACE() with TINY_SERIAL_LOG_BINARY, the level letter is prepended to the format string
+LEVEL_PATTERN = re.compile(r'TINY_(ERROR|WARN|INFO|DEBUG|TRACE)\s*\([^,"]*,\s*((?:"(?:[^"\\]|\\.)*"\s*)+)')
+LITERAL_PATTERN = re.compile(r'"((?:[^"\\]|\\.)*)"')
+# Flags, width and precision are parsed like tinyLogSizeCode() of ATtinySerialOut.h, the letter is checked in getConversions()
+CONVERSION_PATTERN = re.compile(r'%(%|[-+ #\d]*(?:\.\d*)?(hh|h|l)?(.?))')
+INTEGER_CONVERSIONS = 'diuxXo'
+FLOAT_CONVERSIONS = 'feEgG'
+
+
+def fnv1a16(aBytes):
+    tHash = 2166136261
+    for tByte in aBytes:
+        tHash = ((tHash ^ tByte) * 16777619) & 0xFFFFFFFF
+    return (tHash ^ (tHash >> 16)) & 0xFFFF
+
+
+def unescape(aLiteral):
+    return aLiteral.encode('latin-1').decode('unicode_escape').encode('latin-1')
+
+
+def getConversions(aFormat):
+    """ Returns the struct format and a python format string """
+    tStructFormat = '<'
+    tPythonFormat = ''
+    tLastEnd = 0
+    for tMatch in CONVERSION_PATTERN.finditer(aFormat):
+        tPythonFormat += aFormat[tLastEnd:tMatch.start()]
+        tLastEnd = tMatch.end()
+        if tMatch.group(1) == '%':
+            tPythonFormat += '%%'
+            continue
+        tLength = tMatch.group(2)
+        tConversion = tMatch.group(3)
+        if tConversion == '' or tConversion not in INTEGER_CONVERSIONS + FLOAT_CONVERSIONS + 'c':
+            raise ValueError('unsupported conversion "%s"' % tMatch.group(0))
+        if tConversion in FLOAT_CONVERSIONS:
+            tStructFormat += 'f'
+        elif tConversion == 'c':
+            tStructFormat += 'c'
+        else:
+            tCode = {'hh': 'b', 'l': 'l'}.get(tLength, 'h')
+            if tConversion not in 'di':
+                tCode = tCode.upper()
+            tStructFormat += tCode
+        # python ignores h and l, but not hh
+        tPythonFormat += '%' + tMatch.group(1).replace('hh', '').replace('h', '').replace('l', '')
+    tPythonFormat += aFormat[tLastEnd:]
+    return tStructFormat, tPythonFormat
+
+
+def readTable(aPaths):
+    tTable = {}
+    tFiles = []
+    for tPath in aPaths:
+        if os.path.isdir(tPath):
+            for tRoot, _, tNames in os.walk(tPath):
+                tFiles += [os.path.join(tRoot, tName) for tName in tNames if tName.endswith(SOURCE_EXTENSIONS)]
+        else:
+            tFiles.append(tPath)
+    for tFile in tFiles:
+        with open(tFile, encoding='latin-1') as tSource:
+            tText = tSource.read()
+        tFormats = [b''.join(unescape(tLiteral) for tLiteral in LITERAL_PATTERN.findall(tMatch.group(1)))
+                    for tMatch in LOG_PATTERN.finditer(tText)]
+        tFormats += [tMatch.group(1)[0].encode('latin-1') + b' '
+                     + b''.join(unescape(tLiteral) for tLiteral in LITERAL_PATTERN.findall(tMatch.group(2)))
+                     for tMatch in LEVEL_PATTERN.finditer(tText)]
+        for tFormatBytes in tFormats:
+            tFormat = tFormatBytes.decode('latin-1')
+            tId = fnv1a16(tFormatBytes)
+            if tId in tTable and tTable[tId][0] != tFormat:
+                print('Warning: ID 0x%04X of "%s" collides with "%s", change one of the strings' % (tId, tFormat, tTable[tId][0]),
+                      file=sys.stderr)
+            try:
+                tTable[tId] = (tFormat,) + getConversions(tFormat)
+            except ValueError as tError:
+                print('Warning: "%s" is skipped, %s' % (tFormat, tError), file=sys.stderr)
+    return tTable
+
+
+def decode(aInput, aOutput, aTable):
+    while True:
+        tByte = aInput.read(1)
+        if not tByte:
+            return
+        if tByte[0] != TINY_LOG_RECORD_START:
+            aOutput.write(tByte)
+            aOutput.flush()
+            continue
+        tIdBytes = aInput.read(2)
+        if len(tIdBytes) < 2:
+            return
+        tId = tIdBytes[0] | (tIdBytes[1] << 8)
+        if tId not in aTable:
+            # Length of the arguments is unknown, so continue with copying
+            aOutput.write(b'<unknown log ID 0x%04X>\n' % tId)
+            continue
+        _, tStructFormat, tPythonFormat = aTable[tId]
+        tArguments = aInput.read(struct.calcsize(tStructFormat))
+        if len(tArguments) < struct.calcsize(tStructFormat):
+            return
+        tValues = struct.unpack(tStructFormat, tArguments)
+        tValues = tuple(tValue.decode('latin-1') if isinstance(tValue, bytes) else tValue for tValue in tValues)
+        aOutput.write((tPythonFormat % tValues + '\n').encode('latin-1'))
+        aOutput.flush()
+
+
+def main():
+    tParser = argparse.ArgumentParser(description='Decode TINY_LOG() records of ATtinySerialOut')
+    tParser.add_argument('sources', nargs='+', help='Source files or directories containing the TINY_LOG() calls')
+    tParser.add_argument('-i', '--input', default='-', help='Serial device or file with the received data, default is stdin')
+    tParser.add_argument('--table', action='store_true', help='Only print the table of IDs and format strings')
+    tArguments = tParser.parse_args()
+
+    tTable = readTable(tArguments.sources)
+    if tArguments.table:
+        for tId, (tFormat, tStructFormat, _) in sorted(tTable.items()):
+            print('0x%04X %-8s "%s"' % (tId, tStructFormat[1:], tFormat))
+        return
+
+    if tArguments.input == '-':
+        tInput = sys.stdin.buffer
+    else:
+        tInput = open(tArguments.input, 'rb', buffering=0)
+    try:
+        decode(tInput, sys.stdout.buffer, tTable)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+#
+# TinyStringCompressor.py
+#
+# Generates TinyStringDictionary.h and TinyStringDictionary.hpp for TINY_SERIAL_COMPRESSED_STRINGS of the ATtinySerialOut library.
+# All FC("...") strings are extracted from the given sources. Words and parts of words, which occur often, are stored once
+# in a dictionary of up to 127 entries and are replaced by the tokens 0x80 to 0xFE in the strings.
+# The words are expanded by the streaming kernel while sending, so the compression costs no bit time.
+#
+# TinyStringDictionary.h contains the compressed strings and can be included in every file using FC().
+# TinyStringDictionary.hpp contains the dictionary and must be included in exactly one file, like ATtinySerialOut.hpp.
+#
+# Usage:
+#   python3 TinyStringCompressor.py -o MySketch/TinyStringDictionary.h MySketch/
+# Then add to your sketch before #include "ATtinySerialOut.hpp":
+#   #include "TinyStringDictionary.hpp"
+# and to all other files using FC() before #include "ATtinySerialOut.h":
+#   #include "TinyStringDictionary.h"
+# Run it again after adding or changing a FC() string.
+#
+#  Copyright (C) 2024  Armin Joachimsmeyer
+#  Email: armin.joachimsmeyer@gmail.com
+#
+#  This file is part of TinySerialOut https://github.com/ArminJo/ATtinySerialOut.
+#
+#  TinySerialOut is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+#  See the GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/gpl.html>.
+#
+
+import argparse
+import os
+import re
+import sys
+
+SOURCE_EXTENSIONS = ('.ino', '.c', '.cpp', '.h', '.hpp')
+# FC( followed by one or more adjacent string literals
+FC_PATTERN = re.compile(r'\bFC\s*\(\s*((?:"(?:[^"\\]|\\.)*"\s*)+)\)')
+LITERAL_PATTERN = re.compile(r'"((?:[^"\\]|\\.)*)"')
+
+MAX_WORDS = 127
+MAX_WORD_LENGTH = 32
+FIRST_TOKEN = 0x80
+POINTER_SIZE = 2  # size of an entry of sTinyDictionary
+
+
+def fnv1a16(aBytes):
+    """ Same as tinyLogId() of ATtinySerialOut.h """
+    tHash = 2166136261
+    for tByte in aBytes:
+        tHash = ((tHash ^ tByte) * 16777619) & 0xFFFFFFFF
+    return (tHash ^ (tHash >> 16)) & 0xFFFF
+
+
+def unescape(aLiteral):
+    return aLiteral.encode('latin-1').decode('unicode_escape').encode('latin-1')
+
+
+def readStrings(aPaths):
+    tFiles = []
+    for tPath in aPaths:
+        if os.path.isdir(tPath):
+            for tRoot, _, tNames in os.walk(tPath):
+                tFiles += [os.path.join(tRoot, tName) for tName in sorted(tNames) if tName.endswith(SOURCE_EXTENSIONS)]
+        else:
+            tFiles.append(tPath)
+    tStrings = {}
+    for tFile in tFiles:
+        with open(tFile, encoding='latin-1') as tSource:
+            tText = tSource.read()
+        for tMatch in FC_PATTERN.finditer(tText):
+            tString = b''.join(unescape(tLiteral) for tLiteral in LITERAL_PATTERN.findall(tMatch.group(1)))
+            if any(tByte >= FIRST_TOKEN or tByte == 0 for tByte in tString):
+                sys.exit('Error: FC() string "%s" in %s contains non ASCII characters' % (tString.decode('latin-1'), tFile))
+            tId = fnv1a16(tString)
+            if tId in tStrings and tStrings[tId] != tString:
+                sys.exit('Error: FC() strings "%s" and "%s" have the same ID 0x%04X, please change one of them'
+                         % (tString.decode('latin-1'), tStrings[tId].decode('latin-1'), tId))
+            tStrings[tId] = tString
+    return tFiles, tStrings
+
+
+def countOccurrences(aStrings, aWord):
+    """ Non overlapping occurrences in the plain parts of all strings. Tokens are stored as int, plain parts as bytes """
+    return sum(tPart.count(aWord) for tParts in aStrings for tPart in tParts if isinstance(tPart, bytes))
+
+
+def replaceWord(aParts, aWord, aToken):
+    tNewParts = []
+    for tPart in aParts:
+        if isinstance(tPart, bytes):
+            tPieces = tPart.split(aWord)
+            for tIndex, tPiece in enumerate(tPieces):
+                if tIndex > 0:
+                    tNewParts.append(aToken)
+                if tPiece:
+                    tNewParts.append(tPiece)
+        else:
+            tNewParts.append(tPart)
+    return tNewParts
+
+
+def buildDictionary(aStrings):
+    """ Greedy: always take the word with the highest saving, including its own size and the pointer in sTinyDictionary """
+    tStrings = [[tString] for tString in aStrings]
+    tWords = []
+    while len(tWords) < MAX_WORDS:
+        tCandidates = {}
+        for tParts in tStrings:
+            for tPart in tParts:
+                if not isinstance(tPart, bytes):
+                    continue
+                for tStart in range(len(tPart)):
+                    for tLength in range(2, min(MAX_WORD_LENGTH, len(tPart) - tStart) + 1):
+                        tWord = tPart[tStart:tStart + tLength]
+                        tCandidates[tWord] = tCandidates.get(tWord, 0) + 1
+        tBestWord = None
+        tBestSaving = 0
+        # Overlapping counts are an upper bound, so compute the exact saving only for promising candidates
+        tUpperBounds = sorted(((tCount * (len(tWord) - 1) - (len(tWord) + 1 + POINTER_SIZE), tWord) for tWord, tCount in tCandidates.items()),
+                              reverse=True)
+        for tUpperBound, tWord in tUpperBounds:
+            if tUpperBound <= tBestSaving:
+                break
+            tSaving = countOccurrences(tStrings, tWord) * (len(tWord) - 1) - (len(tWord) + 1 + POINTER_SIZE)
+            if tSaving > tBestSaving:
+                tBestWord = tWord
+                tBestSaving = tSaving
+        if tBestWord is None:
+            break
+        tToken = FIRST_TOKEN + len(tWords)
+        tWords.append(tBestWord)
+        tStrings = [replaceWord(tParts, tBestWord, tToken) for tParts in tStrings]
+    return tWords, tStrings
+
+
+def toCString(aParts):
+    """ Tokens are written as separate hex literals, to avoid that following hex digits are taken as part of the escape """
+    tResult = []
+    for tPart in aParts:
+        if isinstance(tPart, bytes):
+            tText = ''
+            for tByte in tPart:
+                tChar = chr(tByte)
+                if tChar in '"\\':
+                    tText += '\\' + tChar
+                elif tChar == '\n':
+                    tText += '\\n'
+                elif tChar == '\r':
+                    tText += '\\r'
+                elif tChar == '\t':
+                    tText += '\\t'
+                elif tByte < 0x20 or tByte == 0x7F:
+                    tText += '\\%03o' % tByte
+                else:
+                    tText += tChar
+            tResult.append('"%s"' % tText)
+        else:
+            tResult.append('"\\x%02X"' % tPart)
+    return ' '.join(tResult) if tResult else '""'
+
+
+def partsLength(aParts):
+    return sum(len(tPart) if isinstance(tPart, bytes) else 1 for tPart in aParts) + 1
+
+
+def main():
+    tParser = argparse.ArgumentParser(description='Generate the compressed FC() strings for ATtinySerialOut')
+    tParser.add_argument('sources', nargs='+', help='Source files or directories containing the FC() strings')
+    tParser.add_argument('-o', '--output', default='TinyStringDictionary.h',
+                         help='Generated header, default is TinyStringDictionary.h. The dictionary is written to the same name with .hpp')
+    tArguments = tParser.parse_args()
+
+    tFiles, tStringsById = readStrings(tArguments.sources)
+    tIds = sorted(tStringsById)
+    tWords, tCompressedStrings = buildDictionary([tStringsById[tId] for tId in tIds])
+
+    tUncompressedSize = sum(len(tString) + 1 for tString in tStringsById.values())
+    tCompressedSize = sum(partsLength(tParts) for tParts in tCompressedStrings) + sum(len(tWord) + 1 + POINTER_SIZE for tWord in tWords)
+
+    tDictionaryOutput = os.path.splitext(tArguments.output)[0] + '.hpp'
+    tSources = ', '.join(os.path.basename(tFile) for tFile in tFiles)
+    tStatistics = '%d strings, %d words, %d bytes instead of %d bytes' % (len(tIds), len(tWords), tCompressedSize, tUncompressedSize)
+
+    def writeHeaderComment(aOutput, aFileName):
+        aOutput.write('/*\n * %s\n *\n * Generated by TinyStringCompressor.py from %s\n * %s\n */\n\n'
+                      % (os.path.basename(aFileName), tSources, tStatistics))
+
+    # The compressed strings, for every file using FC()
+    with open(tArguments.output, 'w') as tOutput:
+        writeHeaderComment(tOutput, tArguments.output)
+        tOutput.write('#ifndef _TINY_STRING_DICTIONARY_H\n#define _TINY_STRING_DICTIONARY_H\n\n')
+        tOutput.write('#if !defined(TINY_SERIAL_COMPRESSED_STRINGS)\n#define TINY_SERIAL_COMPRESSED_STRINGS\n#endif\n')
+        tOutput.write('#include "ATtinySerialOut.h"\n')
+        for tId, tParts in zip(tIds, tCompressedStrings):
+            tOutput.write('\n// %s\n' % toCString([tStringsById[tId]]))
+            tOutput.write('template<> struct TinyCompressedString<0x%04X> {\n' % tId)
+            tOutput.write('    static PGM_P get() {\n')
+            tOutput.write('        static const char tString[] PROGMEM = %s;\n' % toCString(tParts))
+            tOutput.write('        return tString;\n    }\n};\n')
+        tOutput.write('\n#endif // _TINY_STRING_DICTIONARY_H\n')
+
+    # The dictionary, for the one file which includes ATtinySerialOut.hpp
+    with open(tDictionaryOutput, 'w') as tOutput:
+        writeHeaderComment(tOutput, tDictionaryOutput)
+        tOutput.write('#ifndef _TINY_STRING_DICTIONARY_HPP\n#define _TINY_STRING_DICTIONARY_HPP\n\n')
+        tOutput.write('#include "%s"\n\n' % os.path.basename(tArguments.output))
+        for tIndex, tWord in enumerate(tWords):
+            tOutput.write('static const char sTinyWord%d[] PROGMEM = %s;\n' % (tIndex, toCString([tWord])))
+        tOutput.write('\nconst char *const sTinyDictionary[] PROGMEM = { %s };\n'
+                      % (', '.join('sTinyWord%d' % tIndex for tIndex in range(len(tWords))) if tWords else '0'))
+        tOutput.write('\n#endif // _TINY_STRING_DICTIONARY_HPP\n')
+
+    print(tStatistics)
+
+
+if __name__ == '__main__':
+    main()
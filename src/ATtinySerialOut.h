@@ -73,13 +73,17 @@
 #if defined(__AVR_ATtiny13__) || defined(__AVR_ATtiny13A__) || defined(__AVR_ATtiny25__) || defined(__AVR_ATtiny45__) || defined(__AVR_ATtiny85__) \
     || defined(__AVR_ATtiny24__) || defined(__AVR_ATtiny44__) || defined(__AVR_ATtiny84__) \
     || defined(__AVR_ATtiny87__) || defined(__AVR_ATtiny167__) \
-    || defined(__AVR_ATtiny88__)
+    || defined(__AVR_ATtiny88__) || defined(TINY_SERIAL_HOST_TX)
+#if defined(TINY_SERIAL_HOST_TX)
+#include "ATtinySerialOutHost.h"
+#else
 #include <Arduino.h>
+#endif
 
-#define VERSION_ATTINY_SERIAL_OUT "2.3.1"
+#define VERSION_ATTINY_SERIAL_OUT "2.4.0"
 #define VERSION_ATTINY_SERIAL_OUT_MAJOR 2
-#define VERSION_ATTINY_SERIAL_OUT_MINOR 3
-#define VERSION_ATTINY_SERIAL_OUT_PATCH 1
+#define VERSION_ATTINY_SERIAL_OUT_MINOR 4
+#define VERSION_ATTINY_SERIAL_OUT_PATCH 0
 // The change log is at the bottom of the file
 
 /*
@@ -89,12 +93,62 @@
 #define VERSION_HEX_VALUE(major, minor, patch) ((major << 16) | (minor << 8) | (patch))
 #define VERSION_ATTINY_SERIAL_OUT_HEX  VERSION_HEX_VALUE(VERSION_ATTINY_SERIAL_OUT_MAJOR, VERSION_ATTINY_SERIAL_OUT_MINOR, VERSION_ATTINY_SERIAL_OUT_PATCH)
 
-#if (F_CPU != 1000000) &&  (F_CPU != 8000000) &&  (F_CPU != 16000000)
-#error F_CPU value must be 1000000, 8000000 or 16000000.
+#if !defined(STR_HELPER)
+#define STR_HELPER(x) #x
+#define STR(x) STR_HELPER(x)
+#endif
+
+/*
+ * Activate this, to use the USI of ATtiny25/45/85 and ATtiny24/44/84 for hardware timed interrupt driven output.
+ * The USI is clocked by Timer0, which is then no longer available for millis() and delay().
+ * The TX pin is fixed to the USI DO pin, which is PB1 for ATtinyX5 and PA5 for ATtinyX4.
+ * Implies TINY_SERIAL_USE_TX_BUFFER.
+ */
+//#define TINY_SERIAL_USE_USI_TX
+#if defined(TINY_SERIAL_USE_USI_TX) && !defined(TINY_SERIAL_USE_TX_BUFFER)
+#define TINY_SERIAL_USE_TX_BUFFER
+#endif
+
+/*
+ * Activate this, to use the compare output of Timer1 of ATtiny25/45/85 for hardware timed interrupt driven output.
+ * Every bit edge is generated by the compare match, the ISR only selects set or clear for the next match.
+ * So the frames have no jitter, even if the ISR is delayed by other interrupts or cli() for up to one bit time.
+ * The TX pin must be OC1A (PB1, default) or OC1B (PB4). Implies TINY_SERIAL_USE_TX_BUFFER.
+ */
+//#define TINY_SERIAL_USE_TIMER1_OC_TX
+#if defined(TINY_SERIAL_USE_TIMER1_OC_TX)
+#  if !defined(__AVR_ATtiny25__) && !defined(__AVR_ATtiny45__) && !defined(__AVR_ATtiny85__)
+#error TINY_SERIAL_USE_TIMER1_OC_TX is only available for ATtiny25/45/85.
+#  elif defined(TINY_SERIAL_USE_USI_TX)
+#error TINY_SERIAL_USE_TIMER1_OC_TX and TINY_SERIAL_USE_USI_TX cannot be used together.
+#  endif
+#  if !defined(TINY_SERIAL_USE_TX_BUFFER)
+#define TINY_SERIAL_USE_TX_BUFFER
+#  endif
+#endif
+
+/*
+ * Activate this, to enter idle sleep instead of busy waiting, while the TX buffer is full or flush() waits for the last stop bit.
+ * The CPU is woken up by the next TX interrupt, so it is only awake for the ISR and the buffer handling.
+ * Best with TINY_SERIAL_USE_USI_TX or TINY_SERIAL_USE_TIMER1_OC_TX, which require the least ISR cycles.
+ * Sets the sleep mode to idle. Implies TINY_SERIAL_USE_TX_BUFFER.
+ */
+//#define TINY_SERIAL_SLEEP_WHILE_WAITING
+#if defined(TINY_SERIAL_SLEEP_WHILE_WAITING) && !defined(TINY_SERIAL_USE_TX_BUFFER)
+#define TINY_SERIAL_USE_TX_BUFFER
 #endif
 
 #if !defined(TX_PIN)
-#  if defined(__AVR_ATtiny87__) || defined(__AVR_ATtiny167__) // Digispark PRO board
+#  if defined(TINY_SERIAL_USE_USI_TX) || defined(TINY_SERIAL_USE_TIMER1_OC_TX) // TX pin is fixed to USI DO pin or OC1A
+#    if defined(__AVR_ATtiny24__) || defined(__AVR_ATtiny44__) || defined(__AVR_ATtiny84__)
+#define TX_PIN  PIN_PA5
+#    elif defined(DIGISTUMPCORE)
+#define TX_PIN  PB1
+#    else
+#define TX_PIN  PIN_PB1
+#    endif
+
+#  elif defined(__AVR_ATtiny87__) || defined(__AVR_ATtiny167__) // Digispark PRO board
 #    if defined PIN_PA1
 // ATTinyCore
 #define TX_PIN  PIN_PA1 // (package pin 2 / TXD on Tiny167) - can use one of PA0 to PA7 here
@@ -118,6 +172,24 @@
 #  endif
 #endif
 
+/*
+ * Activate this, to use the LIN/UART of ATtiny87/167 for interrupt driven output with arbitrary baud rates up to 1 Mbaud at 16 MHz.
+ * Baud rate is set by Serial.begin() or by setLINUARTBaudrate(), default is TINY_SERIAL_TX_BUFFER_BAUDRATE.
+ * Requires TX_PIN to be the TXD pin PA1, otherwise the bit bang output is used.
+ * Implies TINY_SERIAL_USE_TX_BUFFER.
+ */
+//#define TINY_SERIAL_USE_LIN_UART_TX
+#if defined(TINY_SERIAL_USE_LIN_UART_TX)
+#  if !defined(__AVR_ATtiny87__) && !defined(__AVR_ATtiny167__)
+#error TINY_SERIAL_USE_LIN_UART_TX is only available for ATtiny87/167.
+#  elif (defined(PIN_PA1) && (TX_PIN != PIN_PA1)) || (!defined(PIN_PA1) && (TX_PIN != PA1))
+#warning TX_PIN is not the LIN/UART TXD pin PA1 -> use bit bang output instead of TINY_SERIAL_USE_LIN_UART_TX.
+#undef TINY_SERIAL_USE_LIN_UART_TX
+#  elif !defined(TINY_SERIAL_USE_TX_BUFFER)
+#define TINY_SERIAL_USE_TX_BUFFER
+#  endif
+#endif
+
 /*
  * Activate this, if you want to save 10 bytes code size and if you can live
  * with 87 micro seconds intervals of disabled interrupts for each sent byte @115200 baud.
@@ -132,6 +204,182 @@
 #define _USE_115200BAUD // to avoid double negations
 #endif
 
+/*
+ * Activate this, to be able to change the baud rate of the blocking output at runtime by Serial.begin() or setTXBaudrate().
+ * The delay counts for all standard baud rates from 1200 to 500000, which have at least 23 cycles per bit, are stored in a table in FLASH.
+ * Costs around 130 bytes of program memory plus 9 bytes per table entry and 9 bytes of RAM. Not available for TINY_SERIAL_USE_TX_BUFFER.
+ */
+//#define TINY_SERIAL_RUNTIME_BAUDRATE
+#if defined(TINY_SERIAL_RUNTIME_BAUDRATE) && defined(TINY_SERIAL_USE_TX_BUFFER)
+#warning TINY_SERIAL_RUNTIME_BAUDRATE is not available for TINY_SERIAL_USE_TX_BUFFER and therefore disabled.
+#undef TINY_SERIAL_RUNTIME_BAUDRATE
+#endif
+
+/*
+ * Activate this, to use the unrolled turbo kernel with only 3 cycles per bit, e.g. for 2 Mbaud at 16 MHz or 1 Mbaud at 8 MHz.
+ * It writes the whole TX port with the out instruction, so changes of other pins of this port by an ISR during a frame are lost.
+ * The default baud rate is then 2 Mbaud at 16 MHz, 1 Mbaud at 8 MHz and 250 kbaud at 1 MHz.
+ * Used only for less than 20 cycles per bit, otherwise the loop kernel is used.
+ */
+//#define TINY_SERIAL_USE_TURBO_KERNEL
+
+/*
+ * Activate this, to send strings and buffers by the streaming kernels with exactly one stop bit between the bytes.
+ * Each used string or buffer function then has its own copy of the kernel, which costs around 130 bytes for the loop kernel
+ * and 230 bytes for the unrolled kernels. Not available for TX buffer, runtime baud rate and the host build.
+ */
+//#define TINY_SERIAL_USE_STREAM_KERNEL
+
+/*
+ * Activate this, to store FC("...") strings compressed with a dictionary of common words.
+ * extras/TinyStringCompressor.py generates the compressed strings in TinyStringDictionary.h, which can be included in every file using FC(),
+ * and the dictionary in TinyStringDictionary.hpp, which must be included before ATtinySerialOut.hpp.
+ * Bytes from 0x80 to 0xFE in FC() strings are then tokens for dictionary words, F() and PSTR() strings are sent unchanged. Without this option, FC() is the same as F().
+ */
+//#define TINY_SERIAL_COMPRESSED_STRINGS
+
+/*
+ * Baud rate of the blocking output. The kernel timing is computed at compile time for every F_CPU value.
+ * Less than 20 cycles per bit use the bigger unrolled kernel, which requires at least 7.5 cycles per bit (3 for the turbo kernel).
+ * For TINY_SERIAL_RUNTIME_BAUDRATE, this is the baud rate used before begin() is called.
+ */
+#if !defined(TINY_SERIAL_BAUDRATE)
+#  if defined(TINY_SERIAL_RUNTIME_BAUDRATE) && (F_CPU < 4000000)
+#define TINY_SERIAL_BAUDRATE    38400 // the runtime kernel requires at least 23 cycles per bit
+#  elif defined(TINY_SERIAL_USE_TURBO_KERNEL) && !defined(TINY_SERIAL_RUNTIME_BAUDRATE)
+#    if (F_CPU >= 16000000)
+#define TINY_SERIAL_BAUDRATE    2000000
+#    elif (F_CPU >= 8000000)
+#define TINY_SERIAL_BAUDRATE    1000000
+#    else
+#define TINY_SERIAL_BAUDRATE    250000
+#    endif
+#  elif defined(_USE_115200BAUD)
+#define TINY_SERIAL_BAUDRATE    115200
+#  elif (F_CPU < 4000000)
+#define TINY_SERIAL_BAUDRATE    38400
+#  else
+#define TINY_SERIAL_BAUDRATE    230400
+#  endif
+#endif
+/*
+ * Maximum deviation of any bit edge of a frame from its ideal position in percent of a bit time.
+ * The compiler stops with an error, if the generated timing for F_CPU and TINY_SERIAL_BAUDRATE exceeds this value.
+ * 15 percent leave enough margin for the inaccuracy of the internal RC oscillator.
+ */
+#if !defined(TINY_SERIAL_MAX_TIMING_ERROR_PERCENT)
+#define TINY_SERIAL_MAX_TIMING_ERROR_PERCENT    15
+#endif
+
+/*
+ * Activate this, to put all output into a RAM buffer, which is sent in the background by a timer compare interrupt.
+ * Timer1 is used, for ATtiny13 Timer0 is used, which is then no longer available for millis().
+ * Since the ISR needs around 40 cycles, the baud rate is lower than for the blocking output and can be chosen by TINY_SERIAL_TX_BUFFER_BAUDRATE.
+ * If the buffer is full, write waits until the ISR has sent the next byte.
+ */
+//#define TINY_SERIAL_USE_TX_BUFFER
+#if defined(TINY_SERIAL_USE_TX_BUFFER)
+#  if !defined(TINY_SERIAL_TX_BUFFER_SIZE)
+#define TINY_SERIAL_TX_BUFFER_SIZE  16 // Must be a power of 2
+#  endif
+#  if !defined(TINY_SERIAL_TX_BUFFER_BAUDRATE) && (defined(TINY_SERIAL_USE_USI_TX) || defined(TINY_SERIAL_USE_TIMER1_OC_TX))
+// The USI ISR is called only twice per byte, but must reload the USI within one bit time. The Timer1 OC ISR must finish within one bit time.
+#    if (F_CPU < 4000000)
+#define TINY_SERIAL_TX_BUFFER_BAUDRATE  19200   // 52 cycles per bit
+#    elif (F_CPU < 12000000)
+#define TINY_SERIAL_TX_BUFFER_BAUDRATE  115200  // 69 cycles per bit
+#    else
+#define TINY_SERIAL_TX_BUFFER_BAUDRATE  230400  // 69 cycles per bit
+#    endif
+#  elif !defined(TINY_SERIAL_TX_BUFFER_BAUDRATE) && defined(TINY_SERIAL_USE_LIN_UART_TX)
+#    if (F_CPU < 4000000)
+#define TINY_SERIAL_TX_BUFFER_BAUDRATE  38400   // 115200 has 3.5% error at 1 MHz
+#    else
+#define TINY_SERIAL_TX_BUFFER_BAUDRATE  115200
+#    endif
+#  elif !defined(TINY_SERIAL_TX_BUFFER_BAUDRATE)
+#    if (F_CPU < 4000000)
+#define TINY_SERIAL_TX_BUFFER_BAUDRATE  9600    // 104 cycles per bit
+#    elif (F_CPU < 12000000)
+#define TINY_SERIAL_TX_BUFFER_BAUDRATE  57600   // 139 cycles per bit
+#    else
+#define TINY_SERIAL_TX_BUFFER_BAUDRATE  115200  // 139 cycles per bit
+#    endif
+#  endif
+#  if (TINY_SERIAL_TX_BUFFER_SIZE & (TINY_SERIAL_TX_BUFFER_SIZE - 1)) != 0
+#error TINY_SERIAL_TX_BUFFER_SIZE must be a power of 2.
+#  endif
+#  if defined(TINY_SERIAL_USE_USI_TX)
+#    if ((F_CPU / TINY_SERIAL_TX_BUFFER_BAUDRATE) < 40)
+#error TINY_SERIAL_TX_BUFFER_BAUDRATE is too high for this F_CPU. The USI ISR requires at least 40 cycles per bit.
+#    endif
+#  elif defined(TINY_SERIAL_USE_TIMER1_OC_TX)
+#    if ((F_CPU / TINY_SERIAL_TX_BUFFER_BAUDRATE) < 50)
+#error TINY_SERIAL_TX_BUFFER_BAUDRATE is too high for this F_CPU. The Timer1 OC ISR requires at least 50 cycles per bit.
+#    endif
+#  elif defined(TINY_SERIAL_USE_LIN_UART_TX)
+#    if ((F_CPU / TINY_SERIAL_TX_BUFFER_BAUDRATE) < 8) || ((F_CPU / TINY_SERIAL_TX_BUFFER_BAUDRATE) > (63UL * 4096))
+#error TINY_SERIAL_TX_BUFFER_BAUDRATE is out of range for this F_CPU. The LIN/UART requires 8 to 258048 cycles per bit.
+#    endif
+#  elif ((F_CPU / TINY_SERIAL_TX_BUFFER_BAUDRATE) < 80)
+#error TINY_SERIAL_TX_BUFFER_BAUDRATE is too high for this F_CPU. The ISR requires at least 80 cycles per bit.
+#  endif
+#endif
+
+/*
+ * Activate this, if your program runs with a clock divided by CLKPR, and F_CPU is the clock with division factor 1.
+ * The write and print functions switch CLKPR to division factor 1 for each string, buffer or character and restore it afterwards,
+ * so the kernels for F_CPU are used and full speed power is only required while sending. Timers like millis() run faster during output.
+ * The current division factor is read from CLKPR, use setClockPrescale() to change it with the required timed sequence.
+ */
+//#define TINY_SERIAL_CLOCK_BOOST
+#if defined(TINY_SERIAL_CLOCK_BOOST) && defined(TINY_SERIAL_USE_TX_BUFFER)
+#error TINY_SERIAL_CLOCK_BOOST is not available for TINY_SERIAL_USE_TX_BUFFER, since the ISR requires a fixed clock.
+#endif
+
+/*
+ * Activate this, to keep a post mortem log in RAM, which survives a watchdog, brown-out or external reset.
+ * After startPostMortemLog(), all write and print functions only copy their output to a circular buffer in the .noinit section.
+ * Only the kernel functions write1Start8Data1StopNoParity*() and writeStringWith*CliSei() still write to TX_PIN.
+ * The buffer is protected by a magic number and a checksum. TinySerialOut::begin() or sendPostMortemLog()
+ * send a valid buffer once at the next boot, by the fastest kernel available.
+ */
+//#define TINY_SERIAL_POSTMORTEM_LOG
+#if defined(TINY_SERIAL_POSTMORTEM_LOG)
+#  if !defined(TINY_SERIAL_POSTMORTEM_LOG_SIZE)
+#define TINY_SERIAL_POSTMORTEM_LOG_SIZE 64 // Must be a power of 2 and not greater than 128
+#  endif
+#  if (TINY_SERIAL_POSTMORTEM_LOG_SIZE & (TINY_SERIAL_POSTMORTEM_LOG_SIZE - 1)) != 0 || TINY_SERIAL_POSTMORTEM_LOG_SIZE > 128
+#error TINY_SERIAL_POSTMORTEM_LOG_SIZE must be a power of 2 and not greater than 128.
+#  endif
+#endif
+
+/*
+ * Activate this, to compile the library for the host, e.g. with g++ on x86 Linux, to test, fuzz and benchmark the formatting functions.
+ * The kernel is replaced by a virtual TX line, which appends each byte to sHostTXBuffer and adds the cycles of one frame to sHostTXCycles.
+ * The AVR definitions are taken from ATtinySerialOutHost.h, F_CPU is 8 MHz if not defined.
+ * Only the blocking output is available, calibrateOSCCAL() and writeParallel() are not.
+ */
+//#define TINY_SERIAL_HOST_TX
+#if defined(TINY_SERIAL_HOST_TX)
+#  if defined(TINY_SERIAL_USE_TX_BUFFER) || defined(TINY_SERIAL_RUNTIME_BAUDRATE) || defined(TINY_SERIAL_CLOCK_BOOST) \
+    || defined(TINY_SERIAL_INHERIT_FROM_PRINT)
+#error TINY_SERIAL_HOST_TX is not available for TX buffer, runtime baud rate, clock boost and TINY_SERIAL_INHERIT_FROM_PRINT.
+#  endif
+#  if !defined(TINY_SERIAL_HOST_TX_BUFFER_SIZE)
+#define TINY_SERIAL_HOST_TX_BUFFER_SIZE 1024 // Not greater than 0xFFFF
+#  endif
+#endif
+
+/*
+ * Activate this, to count the bytes sent by Serial, the cycles spent in the TX kernels and the cycles with interrupts disabled.
+ * The cycles are computed from the kernel timing of 10 bit times per byte and not measured, so no timer is required.
+ * The counting adds some cycles to each stop bit. Output of other TinySerialOutT channels is not counted.
+ * With TX buffer, the kernel cycles are the ISR cycles and interrupt locks are not counted.
+ * Print them with Serial.printStats().
+ */
+//#define TINY_SERIAL_STATISTICS
+
 /*
  * If defined, you can use this class as a replacement for standard Serial as a print class e.g.
  * for functions where you require a Print class like in void prinInfo(Print *aSerial). Increases program size.
@@ -146,11 +394,21 @@ class __FlashStringHelper;
 
 extern bool sUseCliSeiForWrite; // default is true
 void useCliSeiForStrings(bool aUseCliSeiForWrite); // might be useful to set to false if output is done from ISR, to avoid to call unwanted sei().
+void setMaxInterruptLockMicros(uint16_t aMaxInterruptLockMicros); // Streaming kernels send strings and buffers in chunks with interrupts disabled, default is 1 byte.
 
 void initTXPin(); // Must be called once if pin is not set to output otherwise
 void write1Start8Data1StopNoParity(uint8_t aValue);
 void write1Start8Data1StopNoParityWithCliSei(uint8_t aValue);
 void writeValue(uint8_t aValue);
+#if defined(TINY_SERIAL_USE_TX_BUFFER)
+void flushTXBuffer(); // Waits until buffer is empty and last stop bit is sent
+#endif
+#if defined(TINY_SERIAL_USE_LIN_UART_TX)
+bool setLINUARTBaudrate(uint32_t aBaudrate); // Returns false and keeps the current baud rate, if aBaudrate is not possible
+#endif
+#if defined(TINY_SERIAL_RUNTIME_BAUDRATE)
+bool setTXBaudrate(uint32_t aBaudrate); // Returns false and keeps the current baud rate, if aBaudrate is not in the table
+#endif
 
 void writeString(const char *aStringPtr);
 void writeString(const __FlashStringHelper *aStringPtr);
@@ -159,6 +417,85 @@ void writeString_E(const char *aStringPtr);
 void writeStringWithCliSei(const char *aStringPtr);
 void writeStringWithoutCliSei(const char *aStringPtr);
 void writeStringSkipLeadingSpaces(const char *aStringPtr);
+void writeBuffer(const uint8_t *aBufferPtr, uint8_t aLength);
+void writeBuffer_P(const uint8_t *aBufferPtr, uint8_t aLength);
+void writeBuffer_E(const uint8_t *aBufferPtr, uint8_t aLength);
+#if !defined(TINY_SERIAL_USE_TX_BUFFER) && !defined(TINY_SERIAL_RUNTIME_BAUDRATE) && !defined(TINY_SERIAL_HOST_TX)
+void writeParallel(const uint8_t aBytes[], uint8_t aPinMask); // aBytes[0] for the lowest pin of aPinMask, all pins on the port of TX_PIN
+#endif
+#if defined(TINY_SERIAL_CLOCK_BOOST)
+void setClockPrescale(uint8_t aClockPrescaleBits); // 0 to 8 for division factor 1 to 256
+#endif
+
+/*
+ * Estimated energy to send one byte with the compile time baud rate, based on the typical supply currents of the ATtiny85 at 3 V.
+ * The energy per cycle scales with the square of VCC. The ISR cycles of the TX buffer are active, the rest is idle
+ * for TINY_SERIAL_SLEEP_WHILE_WAITING and active for busy waiting.
+ * E.g. print getTXEnergyPerByteNanojoule(3000) and getBusyWaitTXEnergyPerByteNanojoule(3000) for 1, 8 and 16 MHz to compare both modes.
+ */
+#if !defined(TINY_SERIAL_ACTIVE_PICOJOULE_PER_CYCLE)
+#define TINY_SERIAL_ACTIVE_PICOJOULE_PER_CYCLE  1125 // 1.5 mA at 4 MHz and 3 V
+#endif
+#if !defined(TINY_SERIAL_IDLE_PICOJOULE_PER_CYCLE)
+#define TINY_SERIAL_IDLE_PICOJOULE_PER_CYCLE    263 // 0.35 mA at 4 MHz and 3 V
+#endif
+uint32_t getTXEnergyPerByteNanojoule(uint16_t aVCCMillivolt); // for the current configuration
+uint32_t getBusyWaitTXEnergyPerByteNanojoule(uint16_t aVCCMillivolt); // if all cycles of a byte are active
+
+/*
+ * OSCCAL calibration of the internal RC oscillator
+ * The reference is one 16 ms period of the watchdog oscillator, or 256 periods of a 32.768 kHz square wave,
+ * e.g. from the 32K output of a RTC, at the pin TINY_SERIAL_CALIBRATION_PIN of the TX port.
+ * The reference count is the number of 6 cycle loops during the reference time.
+ * The watchdog oscillator can be off by up to 10% and drifts with VCC and temperature. So measure its count with measureCalibrationReference()
+ * once at known good conditions, e.g. after factory calibration at 3 V and 25 degree, store it in EEPROM and pass it to calibrateOSCCAL().
+ * Only for the 32.768 kHz reference, TINY_SERIAL_CALIBRATION_NOMINAL_COUNT is the default.
+ * calibrateOSCCAL() takes 1 to 3 measurements, if the oscillator is already calibrated. Interrupts are disabled during measurement.
+ * The watchdog measurement clears WDRF in MCUSR, so read MCUSR before.
+ */
+//#define TINY_SERIAL_CALIBRATION_PIN  PB3 // Bit number on the port of TX_PIN with a 32.768 kHz signal
+#if defined(TINY_SERIAL_CALIBRATION_PIN)
+#define TINY_SERIAL_CALIBRATION_NOMINAL_COUNT   ((F_CPU + 384) / 768) // 256 * 6 cycles per period of 32.768 kHz
+#else
+#define TINY_SERIAL_CALIBRATION_NOMINAL_COUNT   ((F_CPU + 187) / 375) // 16 ms / 6 cycles
+#endif
+#if !defined(TINY_SERIAL_HOST_TX)
+uint16_t measureCalibrationReference(); // Returns the number of 6 cycle loops during the reference time
+#  if defined(TINY_SERIAL_CALIBRATION_PIN)
+bool calibrateOSCCAL(uint16_t aReferenceCount = TINY_SERIAL_CALIBRATION_NOMINAL_COUNT); // Returns true if the clock error is below 2%
+#  else
+bool calibrateOSCCAL(uint16_t aReferenceCount); // Returns true if the clock error is below 2%
+#  endif
+#endif
+
+#if defined(TINY_SERIAL_HOST_TX)
+/*
+ * Virtual TX line of the host build. Frames of TinySerialOutT channels are recorded too.
+ * A frame costs 10 bit times at its baud rate, which is the minimum of all kernels.
+ */
+extern uint8_t sHostTXBuffer[TINY_SERIAL_HOST_TX_BUFFER_SIZE]; // The bytes sent since the last resetHostTX()
+extern uint16_t sHostTXLength; // Stops at TINY_SERIAL_HOST_TX_BUFFER_SIZE
+extern uint32_t sHostTXFrameCount; // Counts all frames, also if sHostTXBuffer is full
+extern uint64_t sHostTXCycles; // Modeled cycles of all frames
+void resetHostTX();
+#endif
+
+#if defined(TINY_SERIAL_STATISTICS)
+struct TinySerialStatistics {
+    uint32_t BytesSent; // Bytes on the wire, i.e. with the words of FC() strings expanded
+    uint32_t KernelCycles;
+    uint32_t InterruptLockCycles; // Total time with interrupts disabled by the kernels, if they were enabled before
+    uint32_t MaxInterruptLockCycles; // Longest single interrupt lock, e.g. one chunk of the streaming kernels
+};
+extern TinySerialStatistics sTinySerialStatistics;
+void resetStatistics();
+#endif
+
+#if defined(TINY_SERIAL_POSTMORTEM_LOG)
+void startPostMortemLog(); // Redirects all output to the post mortem log. Continues a valid log, otherwise starts an empty one.
+void stopPostMortemLog(); // Output goes to TX_PIN again, the log stays valid
+bool sendPostMortemLog(); // Sends and invalidates a valid log, returns false if there was none. Called by TinySerialOut::begin().
+#endif
 
 void writeBinary(uint8_t aByte); // write direct without decoding
 void writeChar(uint8_t aChar); // Synonym for writeBinary
@@ -171,11 +508,326 @@ void writeInt(int16_t aInteger);
 void writeUnsignedInt(uint16_t aInteger);
 void writeLong(int32_t aLong);
 void writeUnsignedLong(uint32_t aLong);
+void writeUnsignedWithBase(uint32_t aValue, uint8_t aBase); // Base 2, 8, 10 and 16 without division
 void writeFloat(double aFloat);
 void writeFloat(double aFloat, uint8_t aDigits);
+void writeFixed(int32_t aValue, uint8_t aFractionalDigits); // Scaled integer, no float library required
+void writeQ8_8(int16_t aValue, uint8_t aFractionalDigits);
+void writeQ16_16(int32_t aValue, uint8_t aFractionalDigits);
 
 char nibbleToHex(uint8_t aByte);
 
+/*
+ * Deferred binary logging
+ * TINY_LOG("Temp=%u Sum=%lu", sTemperature, sSum) sends only a record of TINY_LOG_RECORD_START, the 16 bit ID of the format string
+ * and the raw little endian bytes of the arguments. The format string is only used at compile time and not stored in FLASH.
+ * extras/TinyLogDecoder.py extracts all format strings of the sources and prints the decoded lines and all other output unchanged.
+ * The size of each argument must match its conversion: %c, %hh* 1 byte, %h* %d %i %u %x %X %o 2 bytes, %l* 4 bytes, %f %e %E %g %G 4 bytes.
+ * Other conversions are rejected at compile time and by the decoder.
+ * This is checked at compile time, so cast the arguments if required. For the host build use int16_t for %d %i %u %x and int32_t for %l*.
+ */
+#define TINY_LOG_RECORD_START   0x1E // ASCII record separator
+
+// FNV-1a folded to 16 bit, must be the same as in TinyLogDecoder.py
+constexpr uint32_t tinyLogFNV1a(const char *aString, uint32_t aHash = 2166136261UL) {
+    return (*aString == '\0') ? aHash : tinyLogFNV1a(aString + 1, (aHash ^ (uint8_t) *aString) * 16777619UL);
+}
+constexpr uint16_t tinyLogId(const char *aFormat) {
+    return (uint16_t) (tinyLogFNV1a(aFormat) ^ (tinyLogFNV1a(aFormat) >> 16));
+}
+
+/*
+ * The signature contains 2 bits for each conversion or argument, 1 for 1 byte, 2 for 2 bytes and 3 for 4 bytes.
+ * The first conversion is in the highest bits, so equal signatures also require the same number of arguments.
+ * aIntCode is the code of %d %i %u %x. It is 2 for the records of TINY_LOG(), and the size of int for TINY_PRINTF(),
+ * so TINY_PRINTF("%d", int) also works for the host build.
+ */
+#define TINY_LOG_INT_CODE       (sizeof(int) == 2 ? 2 : 3)
+/*
+ * Only d i u x X o c f e E g G are accepted, all other conversion letters like s or p get code 0.
+ * Then tinyLogSignature() returns TINY_LOG_INVALID_SIGNATURE, which never matches the arguments.
+ */
+constexpr bool tinyLogIsIntegerConversion(char aLetter) {
+    return aLetter == 'd' || aLetter == 'i' || aLetter == 'u' || aLetter == 'x' || aLetter == 'X' || aLetter == 'o';
+}
+constexpr bool tinyLogIsFloatConversion(char aLetter) {
+    return aLetter == 'f' || aLetter == 'e' || aLetter == 'E' || aLetter == 'g' || aLetter == 'G';
+}
+// aIntCode is the code of the integer conversions including their length modifier, %c has always 1 byte and floats 4 bytes
+constexpr uint8_t tinyLogLetterSizeCode(char aLetter, uint8_t aIntCode) {
+    return tinyLogIsIntegerConversion(aLetter) ? aIntCode : (aLetter == 'c') ? 1 : tinyLogIsFloatConversion(aLetter) ? 3 : 0;
+}
+// aConversion points behind the %, flags, width and precision are skipped
+constexpr uint8_t tinyLogSizeCode(const char *aConversion, uint8_t aIntCode) {
+    return (*aConversion == 'h') ?
+            ((aConversion[1] == 'h') ? tinyLogLetterSizeCode(aConversion[2], 1) : tinyLogLetterSizeCode(aConversion[1], 2)) :
+            (*aConversion == 'l') ? tinyLogLetterSizeCode(aConversion[1], 3) :
+            ((*aConversion >= '0' && *aConversion <= '9') || *aConversion == '.' || *aConversion == '-' || *aConversion == '+'
+                    || *aConversion == ' ' || *aConversion == '#') ? tinyLogSizeCode(aConversion + 1, aIntCode) :
+            tinyLogLetterSizeCode(*aConversion, aIntCode);
+}
+// Arguments always have codes 1 to 3, so a signature with 0 in the lowest 2 bits is never generated by TinyLogTypes
+#define TINY_LOG_INVALID_SIGNATURE  0x04
+constexpr uint32_t tinyLogSignature(const char *aFormat, uint8_t aIntCode, uint32_t aSignature = 0) {
+    return (*aFormat == '\0') ? aSignature :
+            (*aFormat != '%') ? tinyLogSignature(aFormat + 1, aIntCode, aSignature) :
+            (aFormat[1] == '%') ? tinyLogSignature(aFormat + 2, aIntCode, aSignature) :
+            (tinyLogSizeCode(aFormat + 1, aIntCode) == 0) ? TINY_LOG_INVALID_SIGNATURE :
+            tinyLogSignature(aFormat + 1, aIntCode, (aSignature << 2) | tinyLogSizeCode(aFormat + 1, aIntCode));
+}
+
+template<typename tArgument> struct TinyLogIsFloat {
+    static const bool value = false;
+};
+template<> struct TinyLogIsFloat<float> {
+    static const bool value = true;
+};
+template<> struct TinyLogIsFloat<double> {
+    static const bool value = true;
+};
+
+// double is stored as float, which is the same on the AVR
+template<typename tArgument> struct TinyLogStored {
+    typedef tArgument type;
+};
+template<> struct TinyLogStored<double> {
+    typedef float type;
+};
+
+template<typename ... tArguments> struct TinyLogTypes;
+template<> struct TinyLogTypes<> {
+    static const uint8_t size = 0;
+    static const uint32_t signature = 0;
+    static const bool hasFloat = false;
+};
+template<typename tArgument, typename ... tArguments> struct TinyLogTypes<tArgument, tArguments...> {
+    static const uint8_t storedSize = sizeof(typename TinyLogStored<tArgument>::type);
+    static_assert(storedSize == 1 || storedSize == 2 || storedSize == 4, "TINY_LOG: arguments must have 1, 2 or 4 bytes");
+    static const uint8_t size = storedSize + TinyLogTypes<tArguments...>::size;
+    static const uint32_t signature = ((uint32_t) (storedSize == 1 ? 1 : (storedSize == 2 ? 2 : 3))
+            << (2 * sizeof...(tArguments))) | TinyLogTypes<tArguments...>::signature;
+    static const bool hasFloat = TinyLogIsFloat<tArgument>::value || TinyLogTypes<tArguments...>::hasFloat;
+};
+
+inline void tinyLogPack(uint8_t *aRecordPtr) {
+    (void) aRecordPtr;
+}
+template<typename tArgument, typename ... tArguments> inline void tinyLogPack(uint8_t *aRecordPtr, tArgument aArgument,
+        tArguments ... aArguments) {
+    typename TinyLogStored<tArgument>::type tStored = aArgument;
+    memcpy(aRecordPtr, &tStored, sizeof(tStored));
+    tinyLogPack(aRecordPtr + sizeof(tStored), aArguments...);
+}
+
+/*
+ * The record is assembled on the stack and sent by one writeBuffer() call
+ */
+template<uint32_t tSignature, typename ... tArguments> void writeLogRecord(uint16_t aId, tArguments ... aArguments) {
+    static_assert(sizeof...(tArguments) <= 16, "TINY_LOG: more than 16 arguments");
+    static_assert(tSignature == TinyLogTypes<tArguments...>::signature, "TINY_LOG: arguments do not match the conversions of the format string");
+    uint8_t tRecord[3 + TinyLogTypes<tArguments...>::size];
+    tRecord[0] = TINY_LOG_RECORD_START;
+    tRecord[1] = aId;
+    tRecord[2] = aId >> 8;
+    tinyLogPack(&tRecord[3], aArguments...);
+    writeBuffer(tRecord, sizeof(tRecord));
+}
+
+#define TINY_LOG(aFormat, ...) do { \
+    constexpr uint16_t tTinyLogId = tinyLogId(aFormat); \
+    writeLogRecord<tinyLogSignature(aFormat, 2)>(tTinyLogId, ##__VA_ARGS__); \
+    } while (0)
+
+/*
+ * Fused printing
+ * TINY_PRINTLN("Temp=%u Sum=%lu", sTemperature, sSum) replaces
+ * Serial.print(F("Temp=")); Serial.print(sTemperature); Serial.print(F(" Sum=")); Serial.println(sSum);
+ * by one call with the FLASH format string and a pointer to the packed arguments.
+ * "\r\n" is appended to the format string at compile time. Arguments are checked like for TINY_LOG(),
+ * but %d %i %u %x take an int of the target, and %f also takes a double.
+ * Only %d %i %u %x %X %o %c %f %e %E %g %G are accepted, e.g. %s or %p fail the compile time check instead of printing a pointer.
+ * Flags and width are ignored, precision is used for %f, default is 2 like for print(double). Hex output is lower case.
+ * Without arguments and without %, the string is written unchanged by writeString(), e.g. TINY_PRINTLN("Start") requires 6 bytes at the call site,
+ * Serial.println(F("Start")) requires 10 bytes. Without arguments but with %%, the string is written by the format parser.
+ * The float library is only required, if one of the arguments is a float.
+ */
+template<bool tWithFloat> void writeFormatted(const __FlashStringHelper *aFormat, const uint8_t *aArguments);
+
+constexpr bool tinyLogHasPercent(const char *aFormat) {
+    return (*aFormat == '\0') ? false : (*aFormat == '%') ? true : tinyLogHasPercent(aFormat + 1);
+}
+
+template<uint32_t tSignature, bool tHasPercent> inline void writeFormattedArguments(const __FlashStringHelper *aFormat) {
+    static_assert(tSignature == 0, "TINY_PRINTF: arguments do not match the conversions of the format string");
+    if (tHasPercent) {
+        writeFormatted<false>(aFormat, NULL); // for %%
+    } else {
+        writeString(aFormat);
+    }
+}
+template<uint32_t tSignature, bool tHasPercent, typename ... tArguments> void writeFormattedArguments(const __FlashStringHelper *aFormat,
+        tArguments ... aArguments) {
+    static_assert(sizeof...(tArguments) <= 16, "TINY_PRINTF: more than 16 arguments");
+    static_assert(tSignature == TinyLogTypes<tArguments...>::signature, "TINY_PRINTF: arguments do not match the conversions of the format string");
+    uint8_t tArgumentBytes[TinyLogTypes<tArguments...>::size];
+    tinyLogPack(tArgumentBytes, aArguments...);
+    writeFormatted<TinyLogTypes<tArguments...>::hasFloat>(aFormat, tArgumentBytes);
+}
+
+#define TINY_PRINTF(aFormat, ...) writeFormattedArguments<tinyLogSignature(aFormat, TINY_LOG_INT_CODE), tinyLogHasPercent(aFormat)>( \
+        F(aFormat), ##__VA_ARGS__)
+#define TINY_PRINTLN(aFormat, ...) writeFormattedArguments<tinyLogSignature(aFormat, TINY_LOG_INT_CODE), tinyLogHasPercent(aFormat)>( \
+        F(aFormat "\r\n"), ##__VA_ARGS__)
+
+/*
+ * Log levels and channels
+ * TINY_INFO(LOG_SENSOR, "Temp=%u", sTemperature) prints "I Temp=23\r\n" by TINY_PRINTLN(), if TINY_SERIAL_LOG_LEVEL is at least
+ * TINY_LOG_LEVEL_INFO and one of the channel bits of LOG_SENSOR is set in sTinyLogChannels.
+ * The channels are bits of your own modules, e.g. #define LOG_SENSOR 0x01. With a single bit constant, the runtime check is one bit test.
+ * Levels above TINY_SERIAL_LOG_LEVEL generate no code, no strings and do not evaluate their arguments.
+ * But their format and arguments are still checked by tinyLogCheckArguments(), like for the enabled levels.
+ */
+#define TINY_LOG_LEVEL_NONE     0
+#define TINY_LOG_LEVEL_ERROR    1
+#define TINY_LOG_LEVEL_WARN     2
+#define TINY_LOG_LEVEL_INFO     3
+#define TINY_LOG_LEVEL_DEBUG    4
+#define TINY_LOG_LEVEL_TRACE    5
+#if !defined(TINY_SERIAL_LOG_LEVEL)
+#define TINY_SERIAL_LOG_LEVEL   TINY_LOG_LEVEL_INFO
+#endif
+/*
+ * Activate this, to send the log levels as deferred binary records by TINY_LOG() instead of text by TINY_PRINTLN().
+ */
+//#define TINY_SERIAL_LOG_BINARY
+
+extern uint8_t sTinyLogChannels; // default is 0xFF, all channels enabled
+
+#if defined(TINY_SERIAL_LOG_BINARY)
+#define TINY_LOG_CHANNEL(aChannels, aFormat, ...) do { \
+    if (sTinyLogChannels & (aChannels)) { \
+        TINY_LOG(aFormat, ##__VA_ARGS__); \
+    } \
+    } while (0)
+#else
+#define TINY_LOG_CHANNEL(aChannels, aFormat, ...) do { \
+    if (sTinyLogChannels & (aChannels)) { \
+        TINY_PRINTLN(aFormat, ##__VA_ARGS__); \
+    } \
+    } while (0)
+#endif
+
+/*
+ * Only checks the arguments against the format string. Called in a never executed branch, so neither the format string nor the arguments
+ * are used at runtime and the compiler generates no code.
+ */
+template<uint32_t tSignature, typename ... tArguments> inline void tinyLogCheckArguments(tArguments ...) {
+    static_assert(sizeof...(tArguments) <= 16, "TINY_LOG: more than 16 arguments");
+    static_assert(tSignature == TinyLogTypes<tArguments...>::signature, "TINY_LOG: arguments do not match the conversions of the format string");
+}
+#if defined(TINY_SERIAL_LOG_BINARY)
+#define TINY_LOG_REMOVED_INT_CODE   2
+#else
+#define TINY_LOG_REMOVED_INT_CODE   TINY_LOG_INT_CODE
+#endif
+#define TINY_LOG_REMOVED(aChannels, aFormat, ...) do { \
+    if (0) { \
+        (void) (aChannels); \
+        tinyLogCheckArguments<tinyLogSignature(aFormat, TINY_LOG_REMOVED_INT_CODE)>(__VA_ARGS__); \
+    } \
+    } while (0)
+
+#if TINY_SERIAL_LOG_LEVEL >= TINY_LOG_LEVEL_ERROR
+#define TINY_ERROR(aChannels, aFormat, ...) TINY_LOG_CHANNEL(aChannels, "E " aFormat, ##__VA_ARGS__)
+#else
+#define TINY_ERROR(aChannels, aFormat, ...) TINY_LOG_REMOVED(aChannels, aFormat, ##__VA_ARGS__)
+#endif
+#if TINY_SERIAL_LOG_LEVEL >= TINY_LOG_LEVEL_WARN
+#define TINY_WARN(aChannels, aFormat, ...) TINY_LOG_CHANNEL(aChannels, "W " aFormat, ##__VA_ARGS__)
+#else
+#define TINY_WARN(aChannels, aFormat, ...) TINY_LOG_REMOVED(aChannels, aFormat, ##__VA_ARGS__)
+#endif
+#if TINY_SERIAL_LOG_LEVEL >= TINY_LOG_LEVEL_INFO
+#define TINY_INFO(aChannels, aFormat, ...) TINY_LOG_CHANNEL(aChannels, "I " aFormat, ##__VA_ARGS__)
+#else
+#define TINY_INFO(aChannels, aFormat, ...) TINY_LOG_REMOVED(aChannels, aFormat, ##__VA_ARGS__)
+#endif
+#if TINY_SERIAL_LOG_LEVEL >= TINY_LOG_LEVEL_DEBUG
+#define TINY_DEBUG(aChannels, aFormat, ...) TINY_LOG_CHANNEL(aChannels, "D " aFormat, ##__VA_ARGS__)
+#else
+#define TINY_DEBUG(aChannels, aFormat, ...) TINY_LOG_REMOVED(aChannels, aFormat, ##__VA_ARGS__)
+#endif
+#if TINY_SERIAL_LOG_LEVEL >= TINY_LOG_LEVEL_TRACE
+#define TINY_TRACE(aChannels, aFormat, ...) TINY_LOG_CHANNEL(aChannels, "T " aFormat, ##__VA_ARGS__)
+#else
+#define TINY_TRACE(aChannels, aFormat, ...) TINY_LOG_REMOVED(aChannels, aFormat, ##__VA_ARGS__)
+#endif
+
+#if defined(TINY_SERIAL_COMPRESSED_STRINGS)
+extern const char *const sTinyDictionary[] PROGMEM; // up to 127 words
+/*
+ * Compressed FLASH strings, the ID is the same as for TINY_LOG().
+ * Specialized for each FC() string in TinyStringDictionary.h.
+ * The error "incomplete type TinyCompressedString<...>" means, that extras/TinyStringCompressor.py must be run again.
+ * FC() has its own pointer type, so only these strings are expanded by writeString() and print().
+ */
+class TinyCompressedStringHelper;
+template<uint16_t tId> struct TinyCompressedString;
+#define FC(aString) (reinterpret_cast<const TinyCompressedStringHelper *>(TinyCompressedString<tinyLogId(aString)>::get()))
+void writeString(const TinyCompressedStringHelper *aStringPtr);
+#else
+#define FC(aString) F(aString)
+#endif
+
+/*
+ * Additional blocking TX channels e.g. for a data logger on another pin or with another baud rate.
+ *   TinySerialOutT<0x18, PB3, 9600> SerialLogger; // 0x18 is the I/O address of PORTB of ATtiny85
+ * Each specialization has its own loop kernel with port, pin and delay counts as constant operands and requires no RAM.
+ * Interrupts are disabled during each frame. At least 20 cycles per bit are required, e.g. 400000 baud at 8 MHz.
+ * TinySerialOutT<TX_PORT_ADDR, TX_BIT_NUMBER, TINY_SERIAL_BAUDRATE> uses the kernel and the write functions of Serial and adds no code.
+ * The functions are defined in ATtinySerialOut.hpp, so use the channels in the file which includes it.
+ */
+template<uint8_t tPortAddress, uint8_t tBitNumber, uint32_t tBaudrate>
+class TinySerialOutT {
+public:
+    static void begin(); // Sets pin to output and high
+    static void write(uint8_t aByte);
+
+    static void print(const __FlashStringHelper *aStringPtr);
+    static void print(const char *aStringPtr);
+#if defined(TINY_SERIAL_COMPRESSED_STRINGS)
+    static void print(const TinyCompressedStringHelper *aStringPtr);
+#endif
+    static void print(char aChar) {
+        write(aChar);
+    }
+    static void print(uint32_t aLong, uint8_t aBase = 10);
+    static void print(int32_t aLong, uint8_t aBase = 10);
+    static void print(uint8_t aByte, uint8_t aBase = 10) {
+        print((uint32_t) aByte, aBase);
+    }
+    static void print(uint16_t aInteger, uint8_t aBase = 10) {
+        print((uint32_t) aInteger, aBase);
+    }
+    static void print(int16_t aInteger, uint8_t aBase = 10) {
+        if (aBase == 10) {
+            print((int32_t) aInteger, aBase);
+        } else {
+            print((uint32_t) (uint16_t) aInteger, aBase); // two's complement like itoa()
+        }
+    }
+
+    template<typename tValue> static void println(tValue aValue) {
+        print(aValue);
+        println();
+    }
+    template<typename tValue> static void println(tValue aValue, uint8_t aBase) {
+        print(aValue, aBase);
+        println();
+    }
+    static void println();
+};
+
 #if defined(TINY_SERIAL_INHERIT_FROM_PRINT)
 class TinySerialOut: public Print
 #else
@@ -186,12 +838,21 @@ public:
 
     void begin(long);
     void end();
-    void flush(void); // not required -> dummy
+    void flush(void); // only required for TINY_SERIAL_USE_TX_BUFFER, otherwise dummy
 
     void printHex(uint8_t aByte); // with 0x prefix
     void printHex(uint16_t aWord); // with 0x prefix
     void printlnHex(uint8_t aByte); // with 0x prefix
     void printlnHex(uint16_t aWord); // with 0x prefix
+    void printFixed(int32_t aValue, uint8_t aFractionalDigits); // printFixed(3550, 3) prints 3.550
+    void printlnFixed(int32_t aValue, uint8_t aFractionalDigits);
+    void printQ8_8(int16_t aValue, uint8_t aFractionalDigits = 2);
+    void printlnQ8_8(int16_t aValue, uint8_t aFractionalDigits = 2);
+    void printQ16_16(int32_t aValue, uint8_t aFractionalDigits = 4);
+    void printlnQ16_16(int32_t aValue, uint8_t aFractionalDigits = 4);
+#if defined(TINY_SERIAL_STATISTICS)
+    void printStats(); // Prints "Bytes=... KernelCycles=... LockCycles=... MaxLockCycles=..." and a newline
+#endif
 
     // virtual functions of Print class
     size_t write(uint8_t aByte);
@@ -219,8 +880,31 @@ public:
     void println(double aFloat, uint8_t aDigits = 2);
 
     void println(void);
+#  if defined(TINY_SERIAL_HOST_TX)
+    // long has 64 bit on the host, so it is truncated to 32 bit like on the AVR
+    void print(long aLong, uint8_t aBase = 10) {
+        print((int32_t) aLong, aBase);
+    }
+    void print(unsigned long aLong, uint8_t aBase = 10) {
+        print((uint32_t) aLong, aBase);
+    }
+    void println(long aLong, uint8_t aBase = 10) {
+        println((int32_t) aLong, aBase);
+    }
+    void println(unsigned long aLong, uint8_t aBase = 10) {
+        println((uint32_t) aLong, aBase);
+    }
+#  endif
 #endif // TINY_SERIAL_INHERIT_FROM_PRINT
 
+#if defined(TINY_SERIAL_COMPRESSED_STRINGS)
+#  if defined(TINY_SERIAL_INHERIT_FROM_PRINT)
+    using Print::print;
+    using Print::println;
+#  endif
+    void print(const TinyCompressedStringHelper *aStringPtr);
+    void println(const TinyCompressedStringHelper *aStringPtr);
+#endif
 };
 
 // This if is required to be compatible with ATTinyCores and AttinyDigisparkCores
@@ -4,6 +4,7 @@
  * For transmitting debug data over bit bang serial with 115200 baud for 1/8/16 MHz ATtiny clock.
  * For 1 MHz you can choose also 38400 baud (120 bytes smaller code size).
  * For 8/16 MHz you can choose also 230400 baud (just faster).
+ * Other F_CPU values and baud rates can be chosen by TINY_SERIAL_BAUDRATE, the timing is then computed at compile time.
  * 1 Start, 8 Data, 1 Stop, No Parity
  *
  * Using PB2 // (Pin7 on Tiny85) as default TX pin to be compatible with digispark board
@@ -39,13 +40,21 @@
 #if defined(__AVR_ATtiny13__) || defined(__AVR_ATtiny13A__) || defined(__AVR_ATtiny25__) || defined(__AVR_ATtiny45__) || defined(__AVR_ATtiny85__) \
     || defined(__AVR_ATtiny24__) || defined(__AVR_ATtiny44__) || defined(__AVR_ATtiny84__) \
     || defined(__AVR_ATtiny87__) || defined(__AVR_ATtiny167__) \
-    || defined(__AVR_ATtiny88__)
+    || defined(__AVR_ATtiny88__) || defined(TINY_SERIAL_HOST_TX)
 #include "ATtinySerialOut.h"
+#if !defined(TINY_SERIAL_HOST_TX)
 #include <avr/eeprom.h>     // for eeprom_read_byte() in writeString_E()
+#endif
+#if defined(TINY_SERIAL_SLEEP_WHILE_WAITING)
+#include <avr/sleep.h>
+#endif
 
 #ifndef _NOP
 #define _NOP()  __asm__ volatile ("nop")
 #endif
+#if !defined(pgm_read_ptr)
+#define pgm_read_ptr(aAddress) ((void *) pgm_read_word(aAddress))
+#endif
 
 #if !defined(PORTB)
 #define PORTB (*(volatile uint8_t *)((0x18) + 0x20))
@@ -87,7 +96,7 @@
 #define TX_DDR          DDRC
 #  endif
 
-#elif defined(__AVR_ATtiny84__) // For use with ATTinyCore
+#elif defined(__AVR_ATtiny24__) || defined(__AVR_ATtiny44__) || defined(__AVR_ATtiny84__) // For use with ATTinyCore
 #  if TX_PIN == PIN_PA0 || TX_PIN == PIN_PA1 || TX_PIN == PIN_PA2 || TX_PIN == PIN_PA3 \
     || TX_PIN == PIN_PA4 || TX_PIN == PIN_PA5 || TX_PIN == PIN_PA6 || TX_PIN == PIN_PA7
 #define TX_PORT         PORTA
@@ -113,8 +122,67 @@
 #endif
 
 void write1Start8Data1StopNoParity(uint8_t aValue);
+#if defined(TINY_SERIAL_USE_TX_BUFFER)
+void initTXBufferHardware();
+#endif
+
+/*
+ * The streaming kernels send a whole string or buffer with exactly one stop bit between the frames,
+ * by fetching the next byte during the stop bit. Only for TINY_SERIAL_USE_STREAM_KERNEL and the compile time kernels.
+ */
+#define TX_STREAM_SOURCE_RAM        0
+#define TX_STREAM_SOURCE_FLASH      1
+#define TX_STREAM_SOURCE_EEPROM     2
+#define TX_STREAM_SOURCE_COMPRESSED 3 // FC() strings in FLASH with tokens for the words of sTinyDictionary
+#if !defined(TINY_SERIAL_USE_TX_BUFFER) && !defined(TINY_SERIAL_RUNTIME_BAUDRATE) && !defined(TINY_SERIAL_HOST_TX)
+#define TX_USE_COMPILE_TIME_KERNEL
+#  if defined(TINY_SERIAL_USE_STREAM_KERNEL)
+#define TX_USE_STREAM_KERNEL
+template<uint8_t tSource, bool tIsString> void writeStream(const uint8_t *aPointer, uint8_t aLength, bool aDisableInterrupts);
+#  endif
+#endif
+#if defined(USE_ALWAYS_CLI_SEI_GUARD_FOR_OUTPUT)
+#define TX_STREAM_STRING_DISABLE_INTERRUPTS true
+#else
+#define TX_STREAM_STRING_DISABLE_INTERRUPTS sUseCliSeiForWrite
+#endif
 
 bool sUseCliSeiForWrite = true;
+uint8_t sTinyLogChannels = 0xFF; // Channel bits of TINY_ERROR() to TINY_TRACE(), which are printed
+#if defined(TX_USE_STREAM_KERNEL)
+uint8_t sStreamChunkLength = 1; // Number of bytes sent by the streaming kernels with interrupts disabled, set by setMaxInterruptLockMicros()
+#endif
+
+#if defined(TINY_SERIAL_STATISTICS)
+TinySerialStatistics sTinySerialStatistics;
+void countTXFrames(uint16_t aNumberOfBytes, uint16_t aNumberOfFrames);
+void countTXInterruptLock(uint8_t aOldSREG, uint16_t aNumberOfFrames, uint8_t aFramesPerLock);
+#define TX_STATISTICS_COUNT_FRAME           countTXFrames(1, 1);
+#define TX_STATISTICS_COUNT_LOCK(aOldSREG)  countTXInterruptLock(aOldSREG, 1, 1);
+/*
+ * The streaming kernels return the pointer behind the terminating 0 of a string.
+ * For FC() strings, the pointer is 0 at the end and the expanded length is counted by getCompressedStringLength().
+ * Without aDisableInterrupts, no interrupt lock is counted.
+ */
+#  if defined(TINY_SERIAL_COMPRESSED_STRINGS)
+uint16_t getCompressedStringLength(const uint8_t *aPointer);
+#define TX_STATISTICS_STRING_LENGTH (tSource == TX_STREAM_SOURCE_COMPRESSED ? getCompressedStringLength(tStatisticsPointer) \
+    : (uint16_t) (aPointer - tStatisticsPointer - 1))
+#  else
+#define TX_STATISTICS_STRING_LENGTH ((uint16_t) (aPointer - tStatisticsPointer - 1))
+#  endif
+#define TX_STATISTICS_STREAM_START  const uint8_t *tStatisticsPointer = aPointer; \
+    uint8_t tStatisticsLength = aLength; \
+    uint8_t tStatisticsOldSREG = aDisableInterrupts ? SREG : 0;
+#define TX_STATISTICS_STREAM_END    uint16_t tStatisticsBytes = tIsString ? TX_STATISTICS_STRING_LENGTH : tStatisticsLength; \
+    countTXFrames(tStatisticsBytes, tStatisticsBytes); \
+    countTXInterruptLock(tStatisticsOldSREG, tStatisticsBytes, sStreamChunkLength);
+#else
+#define TX_STATISTICS_COUNT_FRAME
+#define TX_STATISTICS_COUNT_LOCK(aOldSREG)
+#define TX_STATISTICS_STREAM_START
+#define TX_STATISTICS_STREAM_END
+#endif
 
 /*
  * The Serial Instance!!!
@@ -138,13 +206,22 @@ void initTXPin() {
     TX_PORT |= (1 << TX_BIT_NUMBER);
     // set pin direction to output
     TX_DDR |= (1 << TX_BIT_NUMBER);
+#if defined(TINY_SERIAL_USE_TX_BUFFER)
+    initTXBufferHardware();
+#endif
 }
 
 void write1Start8Data1StopNoParityWithCliSei(uint8_t aValue) {
+#if defined(TINY_SERIAL_USE_TX_BUFFER)
+    // The ISR does the timing, so no need to disable interrupts here
+    write1Start8Data1StopNoParity(aValue);
+#else
     uint8_t oldSREG = SREG;
     cli();
     write1Start8Data1StopNoParity(aValue);
     SREG = oldSREG;
+    TX_STATISTICS_COUNT_LOCK(oldSREG)
+#endif
 }
 
 void writeValue(uint8_t aValue) {
@@ -153,34 +230,219 @@ void writeValue(uint8_t aValue) {
 
 /*
  * Used for writeString() and therefore all write<type>() and print<type>
+ * The streaming kernels only restore SREG and therefore never call an unwanted sei(). With false, they do not disable interrupts.
  */
 void useCliSeiForStrings(bool aUseCliSeiForWrite) {
     sUseCliSeiForWrite = aUseCliSeiForWrite;
 }
 
+#if defined(TINY_SERIAL_POSTMORTEM_LOG)
+/*
+ * The log is not initialized at startup, so it still contains the output before the last reset.
+ * Checksum is the 16 bit sum of the Length bytes before Head. Unlike a CRC, it can be updated in constant time
+ * when the oldest byte is overwritten.
+ */
+struct TinyPostMortemLog {
+    uint16_t Magic;
+    uint16_t Checksum;
+    uint8_t Head; // Index of next byte to write
+    uint8_t Length; // Number of valid bytes, up to TINY_SERIAL_POSTMORTEM_LOG_SIZE
+    uint8_t Buffer[TINY_SERIAL_POSTMORTEM_LOG_SIZE];
+};
+#define TINY_POSTMORTEM_LOG_MAGIC   0x7A3C
+
+TinyPostMortemLog sPostMortemLog __attribute__((section(".noinit")));
+bool sPostMortemLogIsActive = false; // In .bss, so output goes to TX_PIN after each reset
+
+bool isPostMortemLogValid() {
+    if (sPostMortemLog.Magic != TINY_POSTMORTEM_LOG_MAGIC || sPostMortemLog.Head >= TINY_SERIAL_POSTMORTEM_LOG_SIZE
+            || sPostMortemLog.Length > TINY_SERIAL_POSTMORTEM_LOG_SIZE) {
+        return false;
+    }
+    uint16_t tChecksum = 0;
+    uint8_t tIndex = sPostMortemLog.Head;
+    for (uint8_t i = sPostMortemLog.Length; i > 0; i--) {
+        tIndex = (tIndex - 1) & (TINY_SERIAL_POSTMORTEM_LOG_SIZE - 1);
+        tChecksum += sPostMortemLog.Buffer[tIndex];
+    }
+    return tChecksum == sPostMortemLog.Checksum;
+}
+
+void startPostMortemLog() {
+    if (!isPostMortemLogValid()) {
+        sPostMortemLog.Checksum = 0;
+        sPostMortemLog.Head = 0;
+        sPostMortemLog.Length = 0;
+        sPostMortemLog.Magic = TINY_POSTMORTEM_LOG_MAGIC;
+    }
+    sPostMortemLogIsActive = true;
+}
+
+void stopPostMortemLog() {
+    sPostMortemLogIsActive = false;
+}
+
+/*
+ * Around 30 cycles. Interrupts are disabled, since output may also be done from an ISR.
+ */
+void writePostMortemLog(uint8_t aByte) {
+    uint8_t tOldSREG = SREG;
+    cli();
+    uint8_t tHead = sPostMortemLog.Head;
+    uint16_t tChecksum = sPostMortemLog.Checksum + aByte;
+    if (sPostMortemLog.Length < TINY_SERIAL_POSTMORTEM_LOG_SIZE) {
+        sPostMortemLog.Length++;
+    } else {
+        tChecksum -= sPostMortemLog.Buffer[tHead]; // remove the oldest byte
+    }
+    sPostMortemLog.Buffer[tHead] = aByte;
+    sPostMortemLog.Head = (tHead + 1) & (TINY_SERIAL_POSTMORTEM_LOG_SIZE - 1);
+    sPostMortemLog.Checksum = tChecksum;
+    SREG = tOldSREG;
+}
+
+/*
+ * Copies a buffer or, if aLength is 0, a string to the log. Tokens of compressed strings are expanded.
+ */
+void writePostMortemLog(const uint8_t *aPointer, uint8_t aLength, uint8_t aSource) {
+#  if defined(TINY_SERIAL_COMPRESSED_STRINGS)
+    const uint8_t *tSavedPointer = NULL; // not NULL while writing a word of the dictionary
+#  endif
+    while (true) {
+        uint8_t tByte;
+        if (aSource == TX_STREAM_SOURCE_FLASH || aSource == TX_STREAM_SOURCE_COMPRESSED) {
+            tByte = pgm_read_byte(aPointer);
+        } else if (aSource == TX_STREAM_SOURCE_EEPROM) {
+            tByte = eeprom_read_byte(aPointer);
+        } else {
+            tByte = *aPointer;
+        }
+        aPointer++;
+        if (aLength == 0) {
+#  if defined(TINY_SERIAL_COMPRESSED_STRINGS)
+            if (aSource == TX_STREAM_SOURCE_COMPRESSED && tByte == 0 && tSavedPointer != NULL) {
+                aPointer = tSavedPointer;
+                tSavedPointer = NULL;
+                continue;
+            }
+            if (aSource == TX_STREAM_SOURCE_COMPRESSED && tByte >= 0x80 && tByte != 0xFF) {
+                tSavedPointer = aPointer;
+                aPointer = reinterpret_cast<const uint8_t*>(pgm_read_ptr(&sTinyDictionary[tByte & 0x7F]));
+                continue;
+            }
+#  endif
+            // Comparing with 0xFF is safety net for wrong string pointer
+            if (tByte == 0 || (aSource != TX_STREAM_SOURCE_RAM && tByte == 0xFF)) {
+                return;
+            }
+        }
+        writePostMortemLog(tByte);
+        if (aLength != 0 && --aLength == 0) {
+            return;
+        }
+    }
+}
+
+/*
+ * The log is invalidated before sending, so a reset while sending does not send it again
+ */
+bool sendPostMortemLog() {
+    if (sPostMortemLogIsActive || !isPostMortemLogValid()) {
+        return false;
+    }
+    sPostMortemLog.Magic = 0;
+    uint8_t tLength = sPostMortemLog.Length;
+    uint8_t tStart = (sPostMortemLog.Head - tLength) & (TINY_SERIAL_POSTMORTEM_LOG_SIZE - 1);
+    if (tStart + tLength > TINY_SERIAL_POSTMORTEM_LOG_SIZE) {
+        // first send the part up to the end of the buffer
+        writeBuffer(&sPostMortemLog.Buffer[tStart], TINY_SERIAL_POSTMORTEM_LOG_SIZE - tStart);
+        tLength -= TINY_SERIAL_POSTMORTEM_LOG_SIZE - tStart;
+        tStart = 0;
+    }
+    writeBuffer(&sPostMortemLog.Buffer[tStart], tLength);
+    return true;
+}
+
+#define TX_POSTMORTEM_REDIRECT(aPointer, aLength, aSource) \
+    if (sPostMortemLogIsActive) { \
+        writePostMortemLog((const uint8_t*) (aPointer), aLength, aSource); \
+        return; \
+    }
+#else
+#define TX_POSTMORTEM_REDIRECT(aPointer, aLength, aSource)
+#endif // defined(TINY_SERIAL_POSTMORTEM_LOG)
+
+#if defined(TINY_SERIAL_CLOCK_BOOST)
+/*
+ * CLKPCE must be followed by the new value within 4 cycles, so interrupts are disabled.
+ */
+void setClockPrescale(uint8_t aClockPrescaleBits) {
+    uint8_t tOldSREG = SREG;
+    cli();
+    CLKPR = _BV(CLKPCE);
+    CLKPR = aClockPrescaleBits;
+    SREG = tOldSREG;
+}
+
+/*
+ * Switches to division factor 1 and returns the previous prescale bits for restoreClockPrescale().
+ * The new clock is active after at most 2 cycles of the new clock, which is long before the first start bit.
+ */
+uint8_t boostClockPrescale() {
+    uint8_t tClockPrescaleBits = CLKPR & 0x0F;
+    if (tClockPrescaleBits != 0) {
+        setClockPrescale(0);
+    }
+    return tClockPrescaleBits;
+}
+
+inline void restoreClockPrescale(uint8_t aClockPrescaleBits) {
+    if (aClockPrescaleBits != 0) {
+        setClockPrescale(aClockPrescaleBits);
+    }
+}
+#define TX_CLOCK_BOOST_START    uint8_t tClockPrescaleBits = boostClockPrescale();
+#define TX_CLOCK_BOOST_END      restoreClockPrescale(tClockPrescaleBits);
+#else
+#define TX_CLOCK_BOOST_START
+#define TX_CLOCK_BOOST_END
+#endif // defined(TINY_SERIAL_CLOCK_BOOST)
+
 /*
  * Write String residing in RAM
  */
 void writeString(const char *aStringPtr) {
-#if !defined(USE_ALWAYS_CLI_SEI_GUARD_FOR_OUTPUT)
+    TX_POSTMORTEM_REDIRECT(aStringPtr, 0, TX_STREAM_SOURCE_RAM)
+    TX_CLOCK_BOOST_START
+#if defined(TX_USE_STREAM_KERNEL)
+    writeStream<TX_STREAM_SOURCE_RAM, true>((const uint8_t*) aStringPtr, 0, TX_STREAM_STRING_DISABLE_INTERRUPTS);
+#else
+#  if !defined(USE_ALWAYS_CLI_SEI_GUARD_FOR_OUTPUT)
     if (sUseCliSeiForWrite) {
-#endif
+#  endif
         while (*aStringPtr != 0) {
             write1Start8Data1StopNoParityWithCliSei(*aStringPtr++);
         }
-#if !defined(USE_ALWAYS_CLI_SEI_GUARD_FOR_OUTPUT)
+#  if !defined(USE_ALWAYS_CLI_SEI_GUARD_FOR_OUTPUT)
     } else {
         while (*aStringPtr != 0) {
             write1Start8Data1StopNoParity(*aStringPtr++);
         }
     }
+#  endif
 #endif
+    TX_CLOCK_BOOST_END
 }
 
 /*
  * Write string residing in program memory (FLASH)
  */
 void writeString_P(const char *aStringPtr) {
+    TX_POSTMORTEM_REDIRECT(aStringPtr, 0, TX_STREAM_SOURCE_FLASH)
+    TX_CLOCK_BOOST_START
+#if defined(TX_USE_STREAM_KERNEL)
+    writeStream<TX_STREAM_SOURCE_FLASH, true>((const uint8_t*) aStringPtr, 0, TX_STREAM_STRING_DISABLE_INTERRUPTS);
+#else
     uint8_t tChar = pgm_read_byte((const uint8_t* ) aStringPtr);
 // Comparing with 0xFF is safety net for wrong string pointer
     while (tChar != 0 && tChar != 0xFF) {
@@ -195,33 +457,64 @@ void writeString_P(const char *aStringPtr) {
 #endif
         tChar = pgm_read_byte((const uint8_t* ) ++aStringPtr);
     }
+#endif
+    TX_CLOCK_BOOST_END
 }
 
 /*
  * Write string residing in program memory (FLASH)
  */
 void writeString(const __FlashStringHelper *aStringPtr) {
+    writeString_P(reinterpret_cast<const char*>(aStringPtr));
+}
+
+#if defined(TINY_SERIAL_COMPRESSED_STRINGS)
+/*
+ * Write FC() string residing in program memory (FLASH). The bytes 0x80 to 0xFE are tokens for the words of sTinyDictionary.
+ */
+void writeString(const TinyCompressedStringHelper *aStringPtr) {
+    TX_POSTMORTEM_REDIRECT(aStringPtr, 0, TX_STREAM_SOURCE_COMPRESSED)
+    TX_CLOCK_BOOST_START
+#  if defined(TX_USE_STREAM_KERNEL)
+    writeStream<TX_STREAM_SOURCE_COMPRESSED, true>((const uint8_t*) aStringPtr, 0, TX_STREAM_STRING_DISABLE_INTERRUPTS);
+#  else
     PGM_P tPGMStringPtr = reinterpret_cast<PGM_P>(aStringPtr);
-    uint8_t tChar = pgm_read_byte((const uint8_t* ) aStringPtr);
-// Comparing with 0xFF is safety net for wrong string pointer
-    while (tChar != 0 && tChar != 0xFF) {
-#if defined(USE_ALWAYS_CLI_SEI_GUARD_FOR_OUTPUT)
-        write1Start8Data1StopNoParityWithCliSei(tChar);
-#else
-        if (sUseCliSeiForWrite) {
-            write1Start8Data1StopNoParityWithCliSei(tChar);
-        } else {
-            write1Start8Data1StopNoParity(tChar);
+    PGM_P tSavedPGMStringPtr = NULL; // not NULL while writing a word of the dictionary
+    uint8_t tChar;
+    while (true) {
+        tChar = pgm_read_byte((const uint8_t* ) tPGMStringPtr);
+        if (tChar == 0 && tSavedPGMStringPtr != NULL) {
+            tPGMStringPtr = tSavedPGMStringPtr;
+            tSavedPGMStringPtr = NULL;
+            continue;
         }
-#endif
-        tChar = pgm_read_byte((const uint8_t* ) ++tPGMStringPtr);
+        if (tChar >= 0x80 && tChar != 0xFF) {
+            tSavedPGMStringPtr = tPGMStringPtr + 1;
+            tPGMStringPtr = reinterpret_cast<PGM_P>(pgm_read_ptr(&sTinyDictionary[tChar & 0x7F]));
+            continue;
+        }
+        // Comparing with 0xFF is safety net for wrong string pointer
+        if (tChar == 0 || tChar == 0xFF) {
+            break;
+        }
+        writeBinary(tChar);
+        tPGMStringPtr++;
     }
+#  endif
+    TX_CLOCK_BOOST_END
 }
+#endif
 
 /*
  * Write string residing in EEPROM space
  */
 void writeString_E(const char *aStringPtr) {
+    TX_POSTMORTEM_REDIRECT(aStringPtr, 0, TX_STREAM_SOURCE_EEPROM)
+    TX_CLOCK_BOOST_START
+#if defined(TX_USE_STREAM_KERNEL)
+    eeprom_busy_wait();
+    writeStream<TX_STREAM_SOURCE_EEPROM, true>((const uint8_t*) aStringPtr, 0, TX_STREAM_STRING_DISABLE_INTERRUPTS);
+#else
     uint8_t tChar = eeprom_read_byte((const uint8_t*) aStringPtr);
     // Comparing with 0xFF is safety net for wrong string pointer
     while (tChar != 0 && tChar != 0xFF) {
@@ -236,6 +529,66 @@ void writeString_E(const char *aStringPtr) {
 #endif
         tChar = eeprom_read_byte((const uint8_t*) ++aStringPtr);
     }
+#endif
+    TX_CLOCK_BOOST_END
+}
+
+/*
+ * Write aLength bytes residing in RAM
+ */
+void writeBuffer(const uint8_t *aBufferPtr, uint8_t aLength) {
+    if (aLength == 0) {
+        return;
+    }
+    TX_POSTMORTEM_REDIRECT(aBufferPtr, aLength, TX_STREAM_SOURCE_RAM)
+    TX_CLOCK_BOOST_START
+#if defined(TX_USE_STREAM_KERNEL)
+    writeStream<TX_STREAM_SOURCE_RAM, false>(aBufferPtr, aLength, true);
+#else
+    do {
+        write1Start8Data1StopNoParityWithCliSei(*aBufferPtr++);
+    } while (--aLength != 0);
+#endif
+    TX_CLOCK_BOOST_END
+}
+
+/*
+ * Write aLength bytes residing in program memory (FLASH)
+ */
+void writeBuffer_P(const uint8_t *aBufferPtr, uint8_t aLength) {
+    if (aLength == 0) {
+        return;
+    }
+    TX_POSTMORTEM_REDIRECT(aBufferPtr, aLength, TX_STREAM_SOURCE_FLASH)
+    TX_CLOCK_BOOST_START
+#if defined(TX_USE_STREAM_KERNEL)
+    writeStream<TX_STREAM_SOURCE_FLASH, false>(aBufferPtr, aLength, true);
+#else
+    do {
+        write1Start8Data1StopNoParityWithCliSei(pgm_read_byte(aBufferPtr++));
+    } while (--aLength != 0);
+#endif
+    TX_CLOCK_BOOST_END
+}
+
+/*
+ * Write aLength bytes residing in EEPROM space
+ */
+void writeBuffer_E(const uint8_t *aBufferPtr, uint8_t aLength) {
+    if (aLength == 0) {
+        return;
+    }
+    TX_POSTMORTEM_REDIRECT(aBufferPtr, aLength, TX_STREAM_SOURCE_EEPROM)
+    TX_CLOCK_BOOST_START
+#if defined(TX_USE_STREAM_KERNEL)
+    eeprom_busy_wait();
+    writeStream<TX_STREAM_SOURCE_EEPROM, false>(aBufferPtr, aLength, true);
+#else
+    do {
+        write1Start8Data1StopNoParityWithCliSei(eeprom_read_byte(aBufferPtr++));
+    } while (--aLength != 0);
+#endif
+    TX_CLOCK_BOOST_END
 }
 
 void writeStringWithoutCliSei(const char *aStringPtr) {
@@ -255,22 +608,17 @@ void writeStringSkipLeadingSpaces(const char *aStringPtr) {
     while (*aStringPtr == ' ' && *aStringPtr != 0) {
         aStringPtr++;
     }
-#if !defined(USE_ALWAYS_CLI_SEI_GUARD_FOR_OUTPUT)
-    if (sUseCliSeiForWrite) {
-#endif
-        while (*aStringPtr != 0) {
-            write1Start8Data1StopNoParityWithCliSei(*aStringPtr++);
-        }
-#if !defined(USE_ALWAYS_CLI_SEI_GUARD_FOR_OUTPUT)
-    } else {
-        while (*aStringPtr != 0) {
-            write1Start8Data1StopNoParity(*aStringPtr++);
-        }
-    }
-#endif
+    writeString(aStringPtr);
 }
 
 void writeBinary(uint8_t aByte) {
+#if defined(TINY_SERIAL_POSTMORTEM_LOG)
+    if (sPostMortemLogIsActive) {
+        writePostMortemLog(aByte);
+        return;
+    }
+#endif
+    TX_CLOCK_BOOST_START
 #if defined(USE_ALWAYS_CLI_SEI_GUARD_FOR_OUTPUT)
     write1Start8Data1StopNoParityWithCliSei(aByte);
 #else
@@ -280,6 +628,7 @@ void writeBinary(uint8_t aByte) {
         write1Start8Data1StopNoParity(aByte);
     }
 #endif
+    TX_CLOCK_BOOST_END
 }
 
 void writeChar(uint8_t aChar) {
@@ -291,28 +640,156 @@ void writeCRLF() {
     writeBinary('\n');
 }
 
+/*
+ * The digits are computed from the most significant digit on and written directly,
+ * so no string buffer and no division like in utoa() or ultoa() is required.
+ * Decimal digits are computed by subtracting powers of ten, 32 bit values use the 16 bit subtraction for the last 4 digits.
+ */
+const uint32_t sPowersOf10Long[] PROGMEM = { 1000000000, 100000000, 10000000, 1000000, 100000, 10000 };
+const uint16_t sPowersOf10[] PROGMEM = { 10000, 1000, 100, 10 };
+
+/*
+ * @param aExponent - 0 to 9
+ */
+uint32_t powerOf10(uint8_t aExponent) {
+    if (aExponent >= 4) {
+        return pgm_read_dword(&sPowersOf10Long[9 - aExponent]);
+    } else if (aExponent != 0) {
+        return pgm_read_word(&sPowersOf10[4 - aExponent]);
+    }
+    return 1;
+}
+
+/*
+ * Lower case like utoa()
+ */
+char digitToChar(uint8_t aDigit) {
+    if (aDigit < 10) {
+        return aDigit + '0';
+    }
+    return aDigit + 'a' - 10;
+}
+
+/*
+ * Writes the digits for all powers of ten from aPowerPtr down to 10 and the last digit.
+ * @param aWriteZeros - true if a leading digit was already written
+ */
+void writeUnsignedDecimalWithTable(uint16_t aValue, const uint16_t *aPowerPtr, bool aWriteZeros) {
+    uint16_t tPower;
+    do {
+        tPower = pgm_read_word(aPowerPtr++);
+        char tDigit = '0';
+        while (aValue >= tPower) {
+            aValue -= tPower;
+            tDigit++;
+        }
+        if (tDigit != '0' || aWriteZeros) {
+            writeBinary(tDigit);
+            aWriteZeros = true;
+        }
+    } while (tPower != 10);
+    writeBinary(aValue + '0');
+}
+
+void writeUnsignedDecimal(uint32_t aValue) {
+    if (aValue <= 0xFFFF) {
+        writeUnsignedDecimalWithTable(aValue, sPowersOf10, false);
+    } else {
+        bool tWriteZeros = false;
+        const uint32_t *tPowerPtr = sPowersOf10Long;
+        do {
+            uint32_t tPower = pgm_read_dword(tPowerPtr++);
+            char tDigit = '0';
+            while (aValue >= tPower) {
+                aValue -= tPower;
+                tDigit++;
+            }
+            if (tDigit != '0' || tWriteZeros) {
+                writeBinary(tDigit);
+                tWriteZeros = true;
+            }
+        } while (tPowerPtr != &sPowersOf10Long[sizeof(sPowersOf10Long) / sizeof(sPowersOf10Long[0])]);
+        // Rest is below 10000, at least one digit was written, since value was > 0xFFFF
+        writeUnsignedDecimalWithTable(aValue, &sPowersOf10[1], true);
+    }
+}
+
+/*
+ * Writes aValue with a decimal point before the last aFractionalDigits digits and with at least aMinimumDigits digits.
+ * No point is written for aFractionalDigits == 0.
+ * @param aFractionalDigits - 0 to 9
+ */
+void writeUnsignedDecimalWithPoint(uint32_t aValue, uint8_t aFractionalDigits, uint8_t aMinimumDigits) {
+    bool tWriteZeros = false;
+    for (uint8_t tExponent = 9; tExponent != 0; tExponent--) {
+        uint32_t tPower = powerOf10(tExponent);
+        char tDigit = '0';
+        while (aValue >= tPower) {
+            aValue -= tPower;
+            tDigit++;
+        }
+        if (tDigit != '0' || tWriteZeros || tExponent < aMinimumDigits) {
+            writeBinary(tDigit);
+            tWriteZeros = true;
+        }
+        if (tExponent == aFractionalDigits) {
+            writeBinary('.');
+        }
+    }
+    writeBinary(aValue + '0');
+}
+
+/*
+ * Base 2, 8 and 16 only require shifts. For octal, the first digit has only 2 bits.
+ */
+template<uint8_t tBitsPerDigit> void writeUnsignedPowerOf2Base(uint32_t aValue) {
+    uint8_t tDigitCount = (32 - 1) / tBitsPerDigit; // digits after the first one
+    uint8_t tDigit = aValue >> (tDigitCount * tBitsPerDigit);
+    aValue <<= 32 - (tDigitCount * tBitsPerDigit);
+    bool tWriteZeros = false;
+    while (true) {
+        if (tDigit != 0 || tWriteZeros) {
+            writeBinary(digitToChar(tDigit));
+            tWriteZeros = true;
+        }
+        if (tDigitCount == 0) {
+            break;
+        }
+        tDigitCount--;
+        tDigit = aValue >> (32 - tBitsPerDigit);
+        aValue <<= tBitsPerDigit;
+    }
+    if (!tWriteZeros) {
+        writeBinary('0');
+    }
+}
+
+void writeUnsignedWithBase(uint32_t aValue, uint8_t aBase) {
+    if (aBase == 10) {
+        writeUnsignedDecimal(aValue);
+    } else if (aBase == 16) {
+        writeUnsignedPowerOf2Base<4>(aValue);
+    } else if (aBase == 2) {
+        writeUnsignedPowerOf2Base<1>(aValue);
+    } else if (aBase == 8) {
+        writeUnsignedPowerOf2Base<3>(aValue);
+    } else {
+        char tStringBuffer[33];
+        ultoa(aValue, tStringBuffer, aBase);
+        writeString(tStringBuffer);
+    }
+}
+
 void writeUnsignedByte(uint8_t aByte) {
-    char tStringBuffer[4];
-    utoa(aByte, tStringBuffer, 10);
-    writeStringSkipLeadingSpaces(tStringBuffer);
+    writeUnsignedDecimalWithTable(aByte, &sPowersOf10[2], false);
 }
 
 /*
  * 2 byte Hex output
  */
 void writeUnsignedByteHex(uint8_t aByte) {
-    char tStringBuffer[3];
-    //    tStringBuffer[0] = nibbleToHex(aByte >> 4);
-    //    tStringBuffer[1] = nibbleToHex(aByte);
-    //    tStringBuffer[2] = '\0';
-    // the utoa() version is 8 bytes smaller than the version with nibbleToHex(), if utoa() is allocated by another function.
-    utoa(aByte, &tStringBuffer[0], 16);
-    if (tStringBuffer[1] == '\0') {
-        tStringBuffer[2] = '\0';
-        tStringBuffer[1] = tStringBuffer[0];
-        tStringBuffer[0] = '0';
-    }
-    writeString(tStringBuffer);
+    writeBinary(digitToChar(aByte >> 4));
+    writeBinary(digitToChar(aByte & 0x0F));
 }
 
 /*
@@ -333,46 +810,210 @@ char nibbleToHex(uint8_t aByte) {
 }
 
 void writeByte(int8_t aByte) {
-    char tStringBuffer[5];
-    itoa(aByte, tStringBuffer, 10);
-    writeStringSkipLeadingSpaces(tStringBuffer);
+    if (aByte < 0) {
+        writeBinary('-');
+        writeUnsignedByte(0 - (uint8_t) aByte);
+    } else {
+        writeUnsignedByte(aByte);
+    }
 }
 
 void writeInt(int16_t aInteger) {
-    char tStringBuffer[7];
-    itoa(aInteger, tStringBuffer, 10);
-    writeStringSkipLeadingSpaces(tStringBuffer);
+    if (aInteger < 0) {
+        writeBinary('-');
+        writeUnsignedDecimalWithTable(0 - (uint16_t) aInteger, sPowersOf10, false);
+    } else {
+        writeUnsignedDecimalWithTable(aInteger, sPowersOf10, false);
+    }
 }
 
 void writeUnsignedInt(uint16_t aInteger) {
-    char tStringBuffer[6];
-    utoa(aInteger, tStringBuffer, 10);
-    writeStringSkipLeadingSpaces(tStringBuffer);
+    writeUnsignedDecimalWithTable(aInteger, sPowersOf10, false);
 }
 
 void writeLong(int32_t aLong) {
-    char tStringBuffer[12];
-    ltoa(aLong, tStringBuffer, 10);
-    writeStringSkipLeadingSpaces(tStringBuffer);
+    if (aLong < 0) {
+        writeBinary('-');
+        writeUnsignedDecimal(0 - (uint32_t) aLong);
+    } else {
+        writeUnsignedDecimal(aLong);
+    }
 }
 
 void writeUnsignedLong(uint32_t aLong) {
-    char tStringBuffer[11];
-    ultoa(aLong, tStringBuffer, 10);
-    writeStringSkipLeadingSpaces(tStringBuffer);
+    writeUnsignedDecimal(aLong);
+}
+
+/*
+ * Prints a scaled integer, e.g. writeFixed(3550, 3) prints 3.550
+ * @param aFractionalDigits - 0 to 9, number of digits after the decimal point
+ */
+void writeFixed(int32_t aValue, uint8_t aFractionalDigits) {
+    if (aFractionalDigits > 9) {
+        aFractionalDigits = 9;
+    }
+    uint32_t tValue = aValue;
+    if (aValue < 0) {
+        writeBinary('-');
+        tValue = 0 - tValue;
+    }
+    writeUnsignedDecimalWithPoint(tValue, aFractionalDigits, aFractionalDigits + 1);
+}
+
+/*
+ * Fixed point values with tFractionalBits bits after the binary point.
+ * The integer and the rounded fraction are scaled by 10^aFractionalDigits and added, so a carry of the fraction increments the integer.
+ * @param aFractionalDigits - 0 to 4, 4 digits resolve 1/65536 and keep the scaled fraction within 32 bit
+ */
+template<uint8_t tFractionalBits> void writeQ(int32_t aValue, uint8_t aFractionalDigits) {
+    if (aFractionalDigits > 4) {
+        aFractionalDigits = 4;
+    }
+    uint32_t tValue = aValue;
+    if (aValue < 0) {
+        writeBinary('-');
+        tValue = 0 - tValue;
+    }
+    uint32_t tInteger = tValue >> tFractionalBits;
+    uint32_t tFraction = tValue & ((1UL << tFractionalBits) - 1);
+    for (uint8_t i = aFractionalDigits; i != 0; i--) {
+        tInteger *= 10; // only shifts and adds, no multiplication
+        tFraction *= 10;
+    }
+    tFraction = (tFraction + (1UL << (tFractionalBits - 1))) >> tFractionalBits;
+    writeUnsignedDecimalWithPoint(tInteger + tFraction, aFractionalDigits, aFractionalDigits + 1);
+}
+
+void writeQ8_8(int16_t aValue, uint8_t aFractionalDigits) {
+    writeQ<8>(aValue, aFractionalDigits);
+}
+
+void writeQ16_16(int32_t aValue, uint8_t aFractionalDigits) {
+    writeQ<16>(aValue, aFractionalDigits);
 }
 
 void writeFloat(double aFloat) {
-    char tStringBuffer[11];
-    dtostrf(aFloat, 10, 3, tStringBuffer);
-    writeStringSkipLeadingSpaces(tStringBuffer);
+    writeFloat(aFloat, 3);
 }
 
+/*
+ * Like Print::printFloat() of Arduino, but the fraction is converted at once and written by the integer digit engine.
+ * Only float subtraction, multiplication and conversion to integer are required, dtostrf() is not used.
+ * Values with a magnitude above 4294967040 print "ovf".
+ * @param aDigits - 0 to 9
+ */
 void writeFloat(double aFloat, uint8_t aDigits) {
-    char tStringBuffer[11];
-    dtostrf(aFloat, 10, aDigits, tStringBuffer);
-    writeStringSkipLeadingSpaces(tStringBuffer);
+    if (isnan(aFloat)) {
+        writeString(F("nan"));
+        return;
+    }
+    if (isinf(aFloat)) {
+        writeString(F("inf"));
+        return;
+    }
+    if (aFloat > 4294967040.0 || aFloat < -4294967040.0) {
+        writeString(F("ovf"));
+        return;
+    }
+    if (aFloat < 0.0) {
+        writeBinary('-');
+        aFloat = -aFloat;
+    }
+    if (aDigits > 9) {
+        aDigits = 9;
+    }
+    uint32_t tInteger = aFloat;
+    uint32_t tPower = powerOf10(aDigits);
+    // all powers of 10 up to 10^9 are exact float values
+    uint32_t tFraction = (aFloat - tInteger) * tPower + 0.5;
+    if (tFraction >= tPower) {
+        tInteger++;
+        tFraction -= tPower;
+    }
+    writeUnsignedDecimal(tInteger);
+    if (aDigits != 0) {
+        writeBinary('.');
+        writeUnsignedDecimalWithPoint(tFraction, 0, aDigits);
+    }
+}
+
+/*
+ * Used by TINY_PRINTF() and TINY_PRINTLN(). aArguments contains the arguments packed with the sizes of the conversions.
+ * Without float, the float library is not linked and float conversions are written as unsigned.
+ */
+template<bool tWithFloat> void writeFormatted(const __FlashStringHelper *aFormat, const uint8_t *aArguments) {
+    PGM_P tFormatPtr = reinterpret_cast<PGM_P>(aFormat);
+    char tChar;
+    while ((tChar = pgm_read_byte(tFormatPtr++)) != '\0') {
+        if (tChar != '%' || (tChar = pgm_read_byte(tFormatPtr++)) == '%') {
+            writeBinary(tChar);
+            continue;
+        }
+        // Skip flags and width
+        while ((tChar >= '0' && tChar <= '9') || tChar == '-' || tChar == '+' || tChar == ' ' || tChar == '#') {
+            tChar = pgm_read_byte(tFormatPtr++);
+        }
+        uint8_t tPrecision = 2;
+        if (tChar == '.') {
+            tPrecision = 0;
+            while ((tChar = pgm_read_byte(tFormatPtr++)) >= '0' && tChar <= '9') {
+                tPrecision = (tPrecision * 10) + (tChar - '0');
+            }
+        }
+        // Same sizes as in tinyLogSizeCode() with TINY_LOG_INT_CODE
+        uint8_t tSize = sizeof(int);
+        if (tChar == 'h') {
+            tSize = 2;
+            tChar = pgm_read_byte(tFormatPtr++);
+            if (tChar == 'h') {
+                tSize = 1;
+                tChar = pgm_read_byte(tFormatPtr++);
+            }
+        } else if (tChar == 'l') {
+            tSize = 4;
+            tChar = pgm_read_byte(tFormatPtr++);
+        }
+        if (tChar == 'c') {
+            tSize = 1;
+        } else if (tinyLogIsFloatConversion(tChar)) {
+            tSize = 4;
+        } else if (!tinyLogIsIntegerConversion(tChar)) {
+            break; // all other conversions are rejected at compile time
+        }
+
+        union {
+            uint32_t Long;
+            float Float;
+        } tValue;
+        tValue.Long = 0;
+        memcpy(&tValue, aArguments, tSize);
+        aArguments += tSize;
+
+        if (tChar == 'd' || tChar == 'i') {
+            // sign extension
+            if (tSize == 1) {
+                writeLong((int8_t) tValue.Long);
+            } else if (tSize == 2) {
+                writeLong((int16_t) tValue.Long);
+            } else {
+                writeLong(tValue.Long);
+            }
+        } else if (tChar == 'x' || tChar == 'X') {
+            writeUnsignedWithBase(tValue.Long, 16);
+        } else if (tChar == 'o') {
+            writeUnsignedWithBase(tValue.Long, 8);
+        } else if (tChar == 'c') {
+            writeBinary(tValue.Long);
+        } else if (tWithFloat && tinyLogIsFloatConversion(tChar)) {
+            writeFloat(tValue.Float, tPrecision);
+        } else {
+            writeUnsignedDecimal(tValue.Long);
+        }
+    }
 }
+// Instantiate both, so that TINY_PRINTF() can be used in other files, which only include ATtinySerialOut.h
+template void writeFormatted<false>(const __FlashStringHelper *aFormat, const uint8_t *aArguments);
+template void writeFormatted<true>(const __FlashStringHelper *aFormat, const uint8_t *aArguments);
 
 /******************************************************
  * The TinySerialOut class functions which implements
@@ -383,29 +1024,39 @@ void writeFloat(double aFloat, uint8_t aDigits) {
  */
 void TinySerialOut::begin(long aBaudrate) {
     initTXPin();
-#if defined(_USE_115200BAUD) // else smaller code, but only 38400 baud at 1 MHz
-    if (aBaudrate != 115200) {
-        println(F("Only 115200 supported!"));
+#if defined(TINY_SERIAL_USE_LIN_UART_TX)
+    if (aBaudrate != TINY_SERIAL_TX_BUFFER_BAUDRATE && (aBaudrate <= 0 || !setLINUARTBaudrate(aBaudrate))) {
+        println(F("Baudrate not supported!"));
     }
-#else
-#if (F_CPU == 1000000)
-    if (aBaudrate != 38400) {
-        println(F("Only 38400 supported!"));
+#elif defined(TINY_SERIAL_USE_TX_BUFFER)
+    if (aBaudrate != TINY_SERIAL_TX_BUFFER_BAUDRATE) {
+        println(F("Only " STR(TINY_SERIAL_TX_BUFFER_BAUDRATE) " supported!"));
+    }
+#elif defined(TINY_SERIAL_RUNTIME_BAUDRATE)
+    if (!setTXBaudrate(aBaudrate)) {
+        println(F("Baudrate not supported!"));
     }
 #else
-    if (aBaudrate != 230400) {
-        println(F("Only 230400 supported!"));
+    if (aBaudrate != TINY_SERIAL_BAUDRATE) {
+        println(F("Only " STR(TINY_SERIAL_BAUDRATE) " supported!"));
     }
 #endif
+#if defined(TINY_SERIAL_POSTMORTEM_LOG)
+    sendPostMortemLog();
 #endif
 }
 
 void TinySerialOut::end() {
-    // no action needed
+#if defined(TINY_SERIAL_USE_TX_BUFFER)
+    flushTXBuffer();
+#endif
 }
 
 void TinySerialOut::flush() {
-    // no action needed, since we do not use a buffer
+#if defined(TINY_SERIAL_USE_TX_BUFFER)
+    flushTXBuffer();
+#endif
+    // no action needed for blocking output
 }
 
 /*
@@ -430,66 +1081,116 @@ void TinySerialOut::printlnHex(uint16_t aWord) {
     println();
 }
 
-// virtual functions of Print class
-size_t TinySerialOut::write(uint8_t aByte) {
-    writeBinary(aByte);
-    return 1;
+void TinySerialOut::printFixed(int32_t aValue, uint8_t aFractionalDigits) {
+    writeFixed(aValue, aFractionalDigits);
 }
-#if !defined(TINY_SERIAL_INHERIT_FROM_PRINT)
 
-void TinySerialOut::print(const char *aStringPtr) {
-    writeString(aStringPtr);
+void TinySerialOut::printlnFixed(int32_t aValue, uint8_t aFractionalDigits) {
+    writeFixed(aValue, aFractionalDigits);
+    println();
 }
 
-void TinySerialOut::print(const __FlashStringHelper *aStringPtr) {
-    writeString(aStringPtr);
+void TinySerialOut::printQ8_8(int16_t aValue, uint8_t aFractionalDigits) {
+    writeQ8_8(aValue, aFractionalDigits);
 }
 
-void TinySerialOut::print(char aChar) {
-    writeBinary(aChar);
+void TinySerialOut::printlnQ8_8(int16_t aValue, uint8_t aFractionalDigits) {
+    writeQ8_8(aValue, aFractionalDigits);
+    println();
 }
 
-void TinySerialOut::print(uint8_t aByte, uint8_t aBase) {
-    if (aBase == 16) {
-        /*
-         * Print Hex always with two characters
-         */
-        writeUnsignedByteHex(aByte);
+void TinySerialOut::printQ16_16(int32_t aValue, uint8_t aFractionalDigits) {
+    writeQ16_16(aValue, aFractionalDigits);
+}
+
+void TinySerialOut::printlnQ16_16(int32_t aValue, uint8_t aFractionalDigits) {
+    writeQ16_16(aValue, aFractionalDigits);
+    println();
+}
+
+#if defined(TINY_SERIAL_STATISTICS)
+/*
+ * The counters are copied before printing, so the bytes of this output are not part of the values printed
+ */
+void TinySerialOut::printStats() {
+    uint8_t tOldSREG = SREG;
+    cli();
+    TinySerialStatistics tStatistics = sTinySerialStatistics;
+    SREG = tOldSREG;
+    writeString(F("Bytes="));
+    writeUnsignedLong(tStatistics.BytesSent);
+    writeString(F(" KernelCycles="));
+    writeUnsignedLong(tStatistics.KernelCycles);
+    writeString(F(" LockCycles="));
+    writeUnsignedLong(tStatistics.InterruptLockCycles);
+    writeString(F(" MaxLockCycles="));
+    writeUnsignedLong(tStatistics.MaxInterruptLockCycles);
+    writeCRLF();
+}
+#endif
+
+// virtual functions of Print class
+size_t TinySerialOut::write(uint8_t aByte) {
+    writeBinary(aByte);
+    return 1;
+}
+#if !defined(TINY_SERIAL_INHERIT_FROM_PRINT)
+
+void TinySerialOut::print(const char *aStringPtr) {
+    writeString(aStringPtr);
+}
+
+void TinySerialOut::print(const __FlashStringHelper *aStringPtr) {
+    writeString(aStringPtr);
+}
+
+void TinySerialOut::print(char aChar) {
+    writeBinary(aChar);
+}
+
+void TinySerialOut::print(uint8_t aByte, uint8_t aBase) {
+    if (aBase == 16) {
+        /*
+         * Print Hex always with two characters
+         */
+        writeUnsignedByteHex(aByte);
     } else {
-        char tStringBuffer[4];
-        utoa(aByte, tStringBuffer, aBase);
-        writeStringSkipLeadingSpaces(tStringBuffer);
+        writeUnsignedWithBase(aByte, aBase);
     }
 }
 
 void TinySerialOut::print(int16_t aInteger, uint8_t aBase) {
-    char tStringBuffer[7];
-    itoa(aInteger, tStringBuffer, aBase);
-    writeStringSkipLeadingSpaces(tStringBuffer);
+    if (aBase == 10) {
+        writeInt(aInteger);
+    } else {
+        // like itoa(), other bases print the two's complement
+        writeUnsignedWithBase((uint16_t) aInteger, aBase);
+    }
 }
 
 void TinySerialOut::print(uint16_t aInteger, uint8_t aBase) {
-    char tStringBuffer[6];
-    utoa(aInteger, tStringBuffer, aBase);
-    writeStringSkipLeadingSpaces(tStringBuffer);
+    if (aBase == 10) {
+        writeUnsignedInt(aInteger);
+    } else {
+        writeUnsignedWithBase(aInteger, aBase);
+    }
 }
 
 void TinySerialOut::print(int32_t aLong, uint8_t aBase) {
-    char tStringBuffer[12];
-    ltoa(aLong, tStringBuffer, aBase);
-    writeStringSkipLeadingSpaces(tStringBuffer);
+    if (aBase == 10) {
+        writeLong(aLong);
+    } else {
+        // like ltoa(), other bases print the two's complement
+        writeUnsignedWithBase(aLong, aBase);
+    }
 }
 
 void TinySerialOut::print(uint32_t aLong, uint8_t aBase) {
-    char tStringBuffer[11];
-    ultoa(aLong, tStringBuffer, aBase);
-    writeStringSkipLeadingSpaces(tStringBuffer);
+    writeUnsignedWithBase(aLong, aBase);
 }
 
 void TinySerialOut::print(double aFloat, uint8_t aDigits) {
-    char tStringBuffer[11];
-    dtostrf(aFloat, 10, aDigits, tStringBuffer);
-    writeStringSkipLeadingSpaces(tStringBuffer);
+    writeFloat(aFloat, aDigits);
 }
 
 void TinySerialOut::println(char aChar) {
@@ -543,10 +1244,120 @@ void TinySerialOut::println() {
 }
 #endif // !defined(TINY_SERIAL_INHERIT_FROM_PRINT)
 
+#if defined(TINY_SERIAL_COMPRESSED_STRINGS)
+void TinySerialOut::print(const TinyCompressedStringHelper *aStringPtr) {
+    writeString(aStringPtr);
+}
+
+void TinySerialOut::println(const TinyCompressedStringHelper *aStringPtr) {
+    writeString(aStringPtr);
+    println();
+}
+#endif
+
 /********************************
  * Basic serial output function
  *******************************/
 
+/*
+ * Compile time timing generator for the blocking kernels.
+ * All values are derived from F_CPU and TINY_SERIAL_BAUDRATE, cycles per bit are handled as fixed point values with 8 bit fraction.
+ *
+ * Bit edges are counted from the start of the cbi/sbi instruction of the start bit edge.
+ * The unrolled kernel is used for less than 20 cycles per bit. It places each edge k exactly at round(k * cycles per bit).
+ * The loop kernel uses the same number of cycles D for each data bit, or alternates D and D + 1 if the fraction is between 1/4 and 3/4.
+ * The start bit is then adjusted to have the remaining error equally distributed to the first and the last edge.
+ */
+#define TX_CYCLES_X256(aBaudrate)   (((F_CPU / (aBaudrate)) * 256) \
+    + ((((F_CPU % (aBaudrate)) * 256) + ((aBaudrate) / 2)) / (aBaudrate)))
+#define TX_CYCLES_PER_BIT_X256      TX_CYCLES_X256(TINY_SERIAL_BAUDRATE)
+#define TX_ROUND_X256(aValueX256)   (((aValueX256) + 128) >> 8)
+#define TX_ABS_DIFF(a, b)           (((a) > (b)) ? ((a) - (b)) : ((b) - (a)))
+// Cycles of 10 bits for statistics and the host build
+#define TX_FRAME_CYCLES(aBaudrate)  TX_ROUND_X256(10 * TX_CYCLES_X256(aBaudrate))
+
+#define TX_USE_UNROLLED_KERNEL  (TX_CYCLES_PER_BIT_X256 < (20 * 256))
+
+/*
+ * Unrolled kernel
+ * 5 cycles from start bit edge to first data edge without padding, 7 cycles between data bits, 5 cycles between bit 7 and stop bit
+ */
+#define TX_UNROLLED_EDGE_CYCLES(aEdge)  TX_ROUND_X256((aEdge) * TX_CYCLES_PER_BIT_X256)
+#define TX_UNROLLED_PADDING_NOPS(aEdge) (TX_UNROLLED_EDGE_CYCLES((aEdge) + 1) - TX_UNROLLED_EDGE_CYCLES(aEdge) - ((aEdge) == 0 || (aEdge) == 8 ? 5 : 7))
+// Stop bit has at least ceil(cycles per bit) cycles before the ret instruction
+#define TX_UNROLLED_STOP_PADDING_NOPS   (((TX_CYCLES_PER_BIT_X256 + 255) >> 8) - 2)
+
+/*
+ * Turbo kernel, same edge positions as unrolled kernel
+ * 3 cycles between all edges without padding, except 1 cycle between bit 7 and stop bit.
+ * 13 cycles from stop bit edge to the next start bit edge, if write1Start8Data1StopNoParity() is called in a tight loop.
+ */
+#define TX_TURBO_PADDING_CYCLES(aEdge)  (TX_UNROLLED_EDGE_CYCLES((aEdge) + 1) - TX_UNROLLED_EDGE_CYCLES(aEdge) - ((aEdge) == 8 ? 1 : 3))
+#define TX_TURBO_STOP_PADDING_CYCLES    ((((TX_CYCLES_PER_BIT_X256 + 255) >> 8) > 13) ? (((TX_CYCLES_PER_BIT_X256 + 255) >> 8) - 13) : 0)
+
+/*
+ * Loop kernel
+ * 7 cycles for start bit without delay loop and padding, 12 cycles for a data bit (14 if alternating), 11 cycles for stop bit including ret and next call.
+ * The delay loop takes 4 * count - 1 cycles.
+ */
+#define TX_ALTERNATE(aBaudrate)     (((TX_CYCLES_X256(aBaudrate) & 0xFF) >= 64) && ((TX_CYCLES_X256(aBaudrate) & 0xFF) < 192))
+#define TX_DATA_CYCLES(aBaudrate)   (TX_ALTERNATE(aBaudrate) ? (TX_CYCLES_X256(aBaudrate) >> 8) : TX_ROUND_X256(TX_CYCLES_X256(aBaudrate)))
+// Start bit = 5 * cycles per bit - 4 * data cycles (- 2 if alternating) centers the error of edge 1 and edge 9
+#define TX_START_CYCLES(aBaudrate)  TX_ROUND_X256((5 * TX_CYCLES_X256(aBaudrate)) - ((4 * TX_DATA_CYCLES(aBaudrate)) + (TX_ALTERNATE(aBaudrate) ? 2 : 0)) * 256)
+
+#define TX_LOOP_ALTERNATE           TX_ALTERNATE(TINY_SERIAL_BAUDRATE)
+#define TX_LOOP_DATA_CYCLES         TX_DATA_CYCLES(TINY_SERIAL_BAUDRATE)
+#define TX_LOOP_DATA_OVERHEAD       (TX_LOOP_ALTERNATE ? 14 : 12)
+#define TX_LOOP_DATA_DELAY_COUNT    ((TX_LOOP_DATA_CYCLES - TX_LOOP_DATA_OVERHEAD) / 4)
+#define TX_LOOP_DATA_PADDING_NOPS   ((TX_LOOP_DATA_CYCLES - TX_LOOP_DATA_OVERHEAD) % 4)
+#define TX_LOOP_START_CYCLES        TX_START_CYCLES(TINY_SERIAL_BAUDRATE)
+#define TX_LOOP_START_DELAY_COUNT   ((TX_LOOP_START_CYCLES - 7) / 4)
+#define TX_LOOP_START_PADDING_NOPS  ((TX_LOOP_START_CYCLES - 7) % 4)
+#define TX_LOOP_STOP_DELAY_COUNT    ((((TX_CYCLES_PER_BIT_X256 + 255) >> 8) - 11 + 3) / 4)
+#define TX_LOOP_EDGE_CYCLES(aEdge)  ((aEdge) == 0 ? 0 : TX_LOOP_START_CYCLES + ((aEdge) - 1) * TX_LOOP_DATA_CYCLES \
+    + (TX_LOOP_ALTERNATE ? ((aEdge) - 1) / 2 : 0))
+
+/*
+ * Runtime baud rate kernel
+ * Same edge timing as loop kernel, but the delay counts and paddings are taken from a table at begin().
+ * 13 cycles for start bit and 18 cycles for a data bit without delay loop and padding, 10 cycles for stop bit including ret and next call.
+ * Flags contains the data padding in bit 0 and 1, the alternate flag in bit 2 and the start padding in bit 4 and 5.
+ */
+#define TX_RUNTIME_START_DELAY_COUNT(aBaudrate) ((TX_START_CYCLES(aBaudrate) - 13) / 4)
+#define TX_RUNTIME_DATA_DELAY_COUNT(aBaudrate)  ((TX_DATA_CYCLES(aBaudrate) - 18) / 4)
+#define TX_RUNTIME_STOP_DELAY_COUNT(aBaudrate)  ((((TX_CYCLES_X256(aBaudrate) + 255) >> 8) - 10 + 3) / 4)
+#define TX_RUNTIME_FLAGS(aBaudrate)             (((TX_DATA_CYCLES(aBaudrate) - 18) % 4) | (TX_ALTERNATE(aBaudrate) ? 0x04 : 0x00) \
+    | (((TX_START_CYCLES(aBaudrate) - 13) % 4) << 4))
+#define TX_RUNTIME_TIMING(aBaudrate)            { (aBaudrate) / 100, TX_RUNTIME_START_DELAY_COUNT(aBaudrate), \
+    TX_RUNTIME_DATA_DELAY_COUNT(aBaudrate), TX_RUNTIME_STOP_DELAY_COUNT(aBaudrate), TX_RUNTIME_FLAGS(aBaudrate) }
+#define TX_RUNTIME_IS_POSSIBLE(aBaudrate)       (TX_CYCLES_X256(aBaudrate) >= (23 * 256) && TX_RUNTIME_STOP_DELAY_COUNT(aBaudrate) <= 0xFFFF)
+
+#define TX_EDGE_CYCLES(aEdge)       (TX_USE_UNROLLED_KERNEL ? TX_UNROLLED_EDGE_CYCLES(aEdge) : TX_LOOP_EDGE_CYCLES(aEdge))
+// Deviation of edge from its ideal position in percent of a bit time
+#define TX_EDGE_ERROR_PERCENT(aEdge) ((TX_ABS_DIFF(TX_EDGE_CYCLES(aEdge) * 256, (aEdge) * TX_CYCLES_PER_BIT_X256) * 100) / TX_CYCLES_PER_BIT_X256)
+
+#if defined(TINY_SERIAL_RUNTIME_BAUDRATE) && !defined(TINY_SERIAL_USE_TX_BUFFER)
+#  if !TX_RUNTIME_IS_POSSIBLE(TINY_SERIAL_BAUDRATE)
+#error TINY_SERIAL_BAUDRATE is not possible for TINY_SERIAL_RUNTIME_BAUDRATE at F_CPU. The runtime kernel requires at least 23 cycles per bit.
+#  endif
+#elif !defined(TINY_SERIAL_USE_TX_BUFFER)
+#  if defined(TINY_SERIAL_USE_TURBO_KERNEL) && (TX_CYCLES_PER_BIT_X256 < (3 * 256))
+#error TINY_SERIAL_BAUDRATE is too high for F_CPU. The turbo kernel requires at least 3 cycles per bit.
+#  elif !defined(TINY_SERIAL_USE_TURBO_KERNEL) && (TX_CYCLES_PER_BIT_X256 < (7 * 256) + 128)
+#error TINY_SERIAL_BAUDRATE is too high for F_CPU. The kernel requires at least 7.5 cycles per bit. Use TINY_SERIAL_USE_TURBO_KERNEL.
+#  endif
+#  if !TX_USE_UNROLLED_KERNEL && (TX_LOOP_STOP_DELAY_COUNT > 0xFFFF || TX_LOOP_DATA_DELAY_COUNT > 0xFFFF)
+#error TINY_SERIAL_BAUDRATE is too low for F_CPU.
+#  endif
+#  if (TX_EDGE_ERROR_PERCENT(1) > TINY_SERIAL_MAX_TIMING_ERROR_PERCENT) || (TX_EDGE_ERROR_PERCENT(2) > TINY_SERIAL_MAX_TIMING_ERROR_PERCENT) \
+    || (TX_EDGE_ERROR_PERCENT(3) > TINY_SERIAL_MAX_TIMING_ERROR_PERCENT) || (TX_EDGE_ERROR_PERCENT(4) > TINY_SERIAL_MAX_TIMING_ERROR_PERCENT) \
+    || (TX_EDGE_ERROR_PERCENT(5) > TINY_SERIAL_MAX_TIMING_ERROR_PERCENT) || (TX_EDGE_ERROR_PERCENT(6) > TINY_SERIAL_MAX_TIMING_ERROR_PERCENT) \
+    || (TX_EDGE_ERROR_PERCENT(7) > TINY_SERIAL_MAX_TIMING_ERROR_PERCENT) || (TX_EDGE_ERROR_PERCENT(8) > TINY_SERIAL_MAX_TIMING_ERROR_PERCENT) \
+    || (TX_EDGE_ERROR_PERCENT(9) > TINY_SERIAL_MAX_TIMING_ERROR_PERCENT)
+#error Timing error for TINY_SERIAL_BAUDRATE at F_CPU exceeds TINY_SERIAL_MAX_TIMING_ERROR_PERCENT.
+#  endif
+#endif
+
 /*
  * Formula is only valid for constant values
  * Loading of constant value adds 2 extra cycles (check .lss file for exact timing)
@@ -566,177 +1377,1650 @@ inline void delay4CyclesExact(uint16_t a4Microseconds) {
     );
 }
 
-#if (F_CPU == 1000000) && defined(_USE_115200BAUD) // else around 120 bytes smaller code, but only 38400 baud at 1 MHz
+// Delay after the last stop bit edge of the streaming and parallel kernels, which is at least cycles per bit
+#define TX_STREAM_STOP_DELAY_COUNT  ((((TX_CYCLES_PER_BIT_X256 + 255) >> 8) + 3) / 4)
+
+#if defined(TX_USE_STREAM_KERNEL)
+/*
+ * Streaming kernels
+ * The next byte is fetched between the stop bit edge and the next start bit edge, which are TX_STREAM_GAP_CYCLES apart for exactly 10 bits per frame.
+ * 6 of these cycles are used by the stop bit edge instruction (2, or 1 + 1 for mov for turbo), the chunk counter (2) and the rjmp to the next frame (2).
+ * Interrupts are disabled for a chunk of sStreamChunkLength frames. The interrupt window after each chunk adds 7 cycles to the stop bit (11 for turbo).
+ * If aDisableInterrupts is false, interrupts are not disabled, e.g. for useCliSeiForStrings(false).
+ * Fetching the next byte takes 4 to 15 cycles, the rest is padded. If the rest is negative, the stop bit is longer by this amount.
+ */
+#define TX_STREAM_GAP_CYCLES        (TX_ROUND_X256(10 * TX_CYCLES_PER_BIT_X256) - TX_EDGE_CYCLES(9))
+#  if defined(EEARH)
+#define TX_STREAM_EEPROM_CYCLES     11 // including 4 cycles CPU halt after setting EERE
+#  else
+#define TX_STREAM_EEPROM_CYCLES     10
+#  endif
+// Fetch including check for end of string or buffer
+#define TX_STREAM_NEXT_CYCLES(aSource, aIsString) (((aSource) == TX_STREAM_SOURCE_RAM ? 2 : ((aSource) == TX_STREAM_SOURCE_EEPROM ? TX_STREAM_EEPROM_CYCLES : 3)) \
+    + ((aIsString) && (aSource) != TX_STREAM_SOURCE_RAM ? 4 : 2))
+#define TX_STREAM_REST_CYCLES(aSource, aIsString) ((long) TX_STREAM_GAP_CYCLES - 6 - TX_STREAM_NEXT_CYCLES(aSource, aIsString))
+// Padding for unrolled and turbo kernel
+#define TX_STREAM_PADDING_CYCLES(aSource, aIsString) (TX_STREAM_REST_CYCLES(aSource, aIsString) > 0 ? TX_STREAM_REST_CYCLES(aSource, aIsString) : 0)
+// Delay loop and padding for loop kernel, the delay loop takes 4 * count + 1 cycles including the 2 ldi
+#define TX_STREAM_DELAY_COUNT(aSource, aIsString) (TX_STREAM_REST_CYCLES(aSource, aIsString) >= 5 ? (TX_STREAM_REST_CYCLES(aSource, aIsString) - 1) / 4 : 0)
+#define TX_STREAM_DELAY_PADDING_NOPS(aSource, aIsString) (TX_STREAM_REST_CYCLES(aSource, aIsString) >= 5 ? \
+    (TX_STREAM_REST_CYCLES(aSource, aIsString) - 1) % 4 : TX_STREAM_PADDING_CYCLES(aSource, aIsString))
+
+#  if defined(EEARH)
+#define TX_STREAM_EEARH_ASM         "out   %[eearh], r31" "\n\t" /* 1 */
+#define TX_STREAM_EEARH_ADDR        _SFR_IO_ADDR(EEARH)
+#  else
+#define TX_STREAM_EEARH_ASM
+#define TX_STREAM_EEARH_ADDR        0
+#  endif
+#  if defined(TINY_SERIAL_COMPRESSED_STRINGS)
+#define TX_STREAM_COMPRESSED        1
+#define TX_STREAM_DICTIONARY        sTinyDictionary
+#  else
+#define TX_STREAM_COMPRESSED        0
+#define TX_STREAM_DICTIONARY        0 // TX_STREAM_SOURCE_COMPRESSED is not used then
+#  endif
+/*
+ * Reads the byte at Z into r22 and increments Z.
+ * For strings jump to aEndLabel at 0 and for FLASH and EEPROM also at 0xFF, which is the safety net for a wrong string pointer.
+ * breq reaches only 63 words forward, so aEndLabel must be near, see TX_STREAM_FIRST_FETCH_ASM.
+ * For FC() strings (TX_STREAM_SOURCE_COMPRESSED), the bytes 0x80 to 0xFE are tokens for the words of sTinyDictionary.
+ * The string pointer is then saved in r18:r19 and Z points to the word. At the end of the word, Z is restored.
+ * A plain character takes 7 cycles like for uncompressed strings, a token adds 24 cycles and the end of a word 14 cycles to this stop bit.
+ */
+#define TX_STREAM_FETCH_ASM(aEndLabel) \
+    ".if %[source] == 0" "\n\t" \
+    "ld    r22, Z+" "\n\t" /* 2 */ \
+    ".elseif %[source] == 3" "\n\t" \
+    "7:" \
+    "lpm   r22, Z+" "\n\t" /* 3 */ \
+    "tst   r22" "\n\t" /* 1 */ \
+    "brmi  8f" "\n\t" /* 1 */ \
+    "brne  9f" "\n\t" /* 2 */ \
+    "movw  r30, r18" "\n\t" /* end of word or string */ \
+    "cp    r18, __zero_reg__" "\n\t" \
+    "cpc   r19, __zero_reg__" "\n\t" \
+    "breq  " aEndLabel "\n\t" \
+    "clr   r18" "\n\t" \
+    "clr   r19" "\n\t" \
+    "rjmp  7b" "\n\t" \
+    "8:" \
+    "cpi   r22, 0xFF" "\n\t" \
+    "breq  " aEndLabel "\n\t" \
+    "movw  r18, r30" "\n\t" \
+    "lsl   r22" "\n\t" /* index * 2, token bit is shifted out */ \
+    "ldi   r30, lo8(%[dictionary])" "\n\t" \
+    "ldi   r31, hi8(%[dictionary])" "\n\t" \
+    "add   r30, r22" "\n\t" \
+    "adc   r31, __zero_reg__" "\n\t" \
+    "lpm   r20, Z+" "\n\t" \
+    "lpm   r31, Z" "\n\t" \
+    "mov   r30, r20" "\n\t" \
+    "rjmp  7b" "\n\t" \
+    "9:" \
+    ".elseif %[source] == 1" "\n\t" \
+    "lpm   r22, Z+" "\n\t" /* 3 */ \
+    ".else" "\n\t" \
+    "out   %[eearl], r30" "\n\t" /* 1 */ \
+    TX_STREAM_EEARH_ASM \
+    "sbi   %[eecr], %[eere]" "\n\t" /* 2 + 4 CPU halt */ \
+    "in    r22, %[eedr]" "\n\t" /* 1 */ \
+    "adiw  r30, 1" "\n\t" /* 2 */ \
+    ".endif" "\n\t" \
+    ".if %[isString] && %[source] != 3" "\n\t" /* compressed strings are already checked */ \
+    "tst   r22" "\n\t" /* 1 */ \
+    "breq  " aEndLabel "\n\t" /* 1 */ \
+    ".if %[source] != 0" "\n\t" \
+    "cpi   r22, 0xFF" "\n\t" /* 1 */ \
+    "breq  " aEndLabel "\n\t" /* 1 */ \
+    ".endif" "\n\t" \
+    ".endif" "\n\t"
+// r18:r19 is 0 if Z points into the string and not into a word of the dictionary
+#define TX_STREAM_DICTIONARY_INIT_ASM \
+    ".if %[source] == 3" "\n\t" \
+    "clr   r18" "\n\t" \
+    "clr   r19" "\n\t" \
+    ".endif" "\n\t"
+/*
+ * Decrements the length for buffers and fetches the next byte
+ */
+#define TX_STREAM_NEXT_ASM \
+    ".if %[isString] == 0" "\n\t" \
+    "dec   %[length]" "\n\t" /* 1 */ \
+    "breq  L%=end" "\n\t" /* 1 */ \
+    ".endif" "\n\t" \
+    TX_STREAM_FETCH_ASM("L%=end")
+/*
+ * The first byte is fetched before the first frame, which is too far away from L%=end for the branches of the fetch.
+ * So they branch backwards to a trampoline. The 2 cycles of the rjmp are spent before the first start bit.
+ * An empty string only restores SREG and skips the stop bit delay.
+ */
+#define TX_STREAM_FIRST_FETCH_ASM \
+    "rjmp  L%=first" "\n\t" \
+    "L%=empty:" \
+    "out   __SREG__, __tmp_reg__" "\n\t" \
+    "rjmp  L%=exit" "\n\t" \
+    "L%=first:" \
+    TX_STREAM_FETCH_ASM("L%=empty")
+/*
+ * Counts the frames of the current chunk in r21 and jumps to the interrupt window after the last frame of the chunk
+ */
+#define TX_STREAM_CHUNK_ASM \
+    "dec   r21" "\n\t" /* 1 */ \
+    "breq  L%=window" "\n\t" /* 1 */ \
+    "L%=windowReturn:"
+/*
+ * Disables interrupts at the start of the stream, if aDisableInterrupts is true. SREG is saved in __tmp_reg__.
+ */
+#define TX_STREAM_START_ASM \
+    "in    __tmp_reg__, __SREG__" "\n\t" \
+    "sbrc  %[disable], 0" "\n\t" \
+    "cli" "\n\t" \
+    "mov   r21, %[chunk]" "\n\t"
+/*
+ * Restores SREG to let pending interrupts be handled, which only prolongs the stop bit by 7 cycles and the ISR duration.
+ * aReloadAsm is executed after the window, e.g. to read values which may have been changed by an ISR.
+ */
+#define TX_STREAM_INTERRUPT_WINDOW_ASM(aReloadAsm) \
+    "L%=window:" \
+    "out   __SREG__, __tmp_reg__" "\n\t" /* 1 */ \
+    "mov   r21, %[chunk]" "\n\t" /* 1  pending interrupt is handled after this instruction */ \
+    "sbrc  %[disable], 0" "\n\t" /* 1-2 */ \
+    "cli" "\n\t" /* 1 */ \
+    aReloadAsm \
+    "rjmp  L%=windowReturn" "\n\t" /* 2 */
+
+#define TX_STREAM_OPERANDS(aSource, aIsString) \
+    [txport] "I" ( TX_PORT_ADDR ), \
+    [txpin] "I" ( TX_BIT_NUMBER ), \
+    [source] "i" ( aSource ), \
+    [isString] "i" ( aIsString ), \
+    [eearl] "I" ( _SFR_IO_ADDR(EEARL) ), \
+    [eearh] "I" ( TX_STREAM_EEARH_ADDR ), \
+    [eecr] "I" ( _SFR_IO_ADDR(EECR) ), \
+    [eere] "I" ( EERE ), \
+    [eedr] "I" ( _SFR_IO_ADDR(EEDR) ), \
+    [stopCount] "i" ( TX_STREAM_STOP_DELAY_COUNT ), \
+    [chunk] "r" ( sStreamChunkLength ), \
+    [disable] "r" ( aDisableInterrupts ), \
+    [dictionary] "i" ( TX_STREAM_DICTIONARY )
+
+// The unrolled kernels may need up to 17 cycles more than 10 bits for fetching the next byte, a word end followed by a token adds 38 cycles
+#define TX_STREAM_MAX_FRAME_CYCLES  (TX_ROUND_X256(10 * TX_CYCLES_PER_BIT_X256) + 17 + (TX_STREAM_COMPRESSED ? 38 : 0))
+#endif // defined(TX_USE_STREAM_KERNEL)
+
+/*
+ * Sets the maximum time in microseconds, for which the string and buffer functions disable interrupts.
+ * Interrupts are then enabled at the stop bit after each chunk of bytes, which fits into this time.
+ * The minimum is one byte, which is also the default.
+ * Has only effect, if the streaming kernels are used.
+ */
+void setMaxInterruptLockMicros(uint16_t aMaxInterruptLockMicros) {
+#if defined(TX_USE_STREAM_KERNEL)
+    uint32_t tChunkLength = ((uint32_t) aMaxInterruptLockMicros * (F_CPU / 1000)) / (1000UL * TX_STREAM_MAX_FRAME_CYCLES);
+    if (tChunkLength == 0) {
+        tChunkLength = 1;
+    } else if (tChunkLength > 0xFF) {
+        tChunkLength = 0xFF;
+    }
+    sStreamChunkLength = tChunkLength;
+#else
+    (void) aMaxInterruptLockMicros;
+#endif
+}
+
+#if defined(TX_USE_COMPILE_TIME_KERNEL)
+/*
+ * Parallel kernel, sends the precomputed port values of one frame with the out instruction.
+ * Each edge is placed at round(k * cycles per bit) like for the unrolled kernel, 3 cycles between edges are required for out and ld.
+ * The remaining cycles are spent by a delay loop of 4 * count + 1 cycles and padding nops.
+ */
+#define TX_PARALLEL_REST_CYCLES(aEdge)      (TX_UNROLLED_EDGE_CYCLES((aEdge) + 1) - TX_UNROLLED_EDGE_CYCLES(aEdge) - 3)
+#define TX_PARALLEL_DELAY_COUNT(aEdge)      (TX_PARALLEL_REST_CYCLES(aEdge) >= 5 ? (TX_PARALLEL_REST_CYCLES(aEdge) - 1) / 4 : 0)
+#define TX_PARALLEL_PADDING_NOPS(aEdge)     (TX_PARALLEL_REST_CYCLES(aEdge) >= 5 ? (TX_PARALLEL_REST_CYCLES(aEdge) - 1) % 4 : TX_PARALLEL_REST_CYCLES(aEdge))
+
+#define TX_PARALLEL_EDGE_ASM(aEdge) \
+    "out   %[txport], r22" "\n\t" /* 1 */ \
+    "ld    r22, Z+" "\n\t" /* 2  value for next edge */ \
+    ".if %[count" #aEdge "]" "\n\t" \
+    "ldi   r24, lo8(%[count" #aEdge "])" "\n\t" /* 1 */ \
+    "ldi   r25, hi8(%[count" #aEdge "])" "\n\t" /* 1 */ \
+    "L%=delay" #aEdge ":" \
+    "sbiw  r24, 1" "\n\t" /* 2 */ \
+    "brne  L%=delay" #aEdge "\n\t" /* 1-2 */ \
+    ".endif" "\n\t" \
+    ".rept %[pad" #aEdge "]" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+#define TX_PARALLEL_EDGE_OPERANDS(aEdge) \
+    [count##aEdge] "i" ( TX_PARALLEL_DELAY_COUNT(aEdge) ), \
+    [pad##aEdge] "i" ( TX_PARALLEL_PADDING_NOPS(aEdge) )
+
+/*
+ * Sends one byte on each pin of aPinMask at the same time, so up to 8 bytes take the time of one byte.
+ * aBytes[0] is sent on the lowest pin of aPinMask, aBytes[1] on the next one and so on. All pins must be on the port of TX_PIN.
+ * The bytes are transposed to one port value per bit before interrupts are disabled. Other pins of the port keep their value.
+ */
+void writeParallel(const uint8_t aBytes[], uint8_t aPinMask) {
+    static_assert(TX_PARALLEL_REST_CYCLES(0) >= 0 && TX_PARALLEL_REST_CYCLES(1) >= 0 && TX_PARALLEL_REST_CYCLES(2) >= 0
+            && TX_PARALLEL_REST_CYCLES(3) >= 0 && TX_PARALLEL_REST_CYCLES(4) >= 0 && TX_PARALLEL_REST_CYCLES(5) >= 0
+            && TX_PARALLEL_REST_CYCLES(6) >= 0 && TX_PARALLEL_REST_CYCLES(7) >= 0 && TX_PARALLEL_REST_CYCLES(8) >= 0,
+            "TINY_SERIAL_BAUDRATE is too high for writeParallel() at F_CPU. The parallel kernel requires at least 3 cycles per bit.");
+    // Start bit, 8 data bits and stop bit
+    uint8_t tPortValues[10];
+    tPortValues[0] = 0;
+    uint8_t tBitMask = 0x01;
+    for (uint8_t tBit = 1; tBit < 9; tBit++) {
+        uint8_t tPortValue = 0;
+        const uint8_t *tBytePtr = aBytes;
+        for (uint8_t tPinMask = 0x01; tPinMask != 0; tPinMask <<= 1) {
+            if (aPinMask & tPinMask) {
+                if (*tBytePtr++ & tBitMask) {
+                    tPortValue |= tPinMask;
+                }
+            }
+        }
+        tPortValues[tBit] = tPortValue;
+        tBitMask <<= 1;
+    }
+    tPortValues[9] = aPinMask;
+
+    TX_CLOCK_BOOST_START
+    uint8_t tOldSREG = SREG;
+    cli();
+    uint8_t tOtherPins = TX_PORT & ~aPinMask;
+    for (uint8_t i = 0; i < 10; i++) {
+        tPortValues[i] |= tOtherPins;
+    }
+    const uint8_t *tPortValuePtr = tPortValues;
+    asm volatile
+    (
+            "ld    r22, Z+" "\n\t"
+            TX_PARALLEL_EDGE_ASM(0)
+            TX_PARALLEL_EDGE_ASM(1)
+            TX_PARALLEL_EDGE_ASM(2)
+            TX_PARALLEL_EDGE_ASM(3)
+            TX_PARALLEL_EDGE_ASM(4)
+            TX_PARALLEL_EDGE_ASM(5)
+            TX_PARALLEL_EDGE_ASM(6)
+            TX_PARALLEL_EDGE_ASM(7)
+            TX_PARALLEL_EDGE_ASM(8)
+            // Stop bit
+            "out   %[txport], r22" "\n\t" /* 1 */
+            "ldi   r24, lo8(%[stopCount])" "\n\t"
+            "ldi   r25, hi8(%[stopCount])" "\n\t"
+            "L%=delayStop:"
+            "sbiw  r24, 1" "\n\t"
+            "brne  L%=delayStop" "\n\t"
+            :
+            [pointer] "+z" ( tPortValuePtr )
+            :
+            [txport] "I" ( TX_PORT_ADDR ),
+            TX_PARALLEL_EDGE_OPERANDS(0),
+            TX_PARALLEL_EDGE_OPERANDS(1),
+            TX_PARALLEL_EDGE_OPERANDS(2),
+            TX_PARALLEL_EDGE_OPERANDS(3),
+            TX_PARALLEL_EDGE_OPERANDS(4),
+            TX_PARALLEL_EDGE_OPERANDS(5),
+            TX_PARALLEL_EDGE_OPERANDS(6),
+            TX_PARALLEL_EDGE_OPERANDS(7),
+            TX_PARALLEL_EDGE_OPERANDS(8),
+            [stopCount] "i" ( TX_STREAM_STOP_DELAY_COUNT )
+            :
+            "r22",
+            "r24",
+            "r25",
+            "memory"
+    );
+    SREG = tOldSREG;
+    TX_CLOCK_BOOST_END
+#if defined(TINY_SERIAL_STATISTICS)
+    countTXFrames(__builtin_popcount(aPinMask), 1);
+    countTXInterruptLock(tOldSREG, 1, 1);
+#endif
+}
+#endif // defined(TX_USE_COMPILE_TIME_KERNEL)
+
+#if defined(TINY_SERIAL_HOST_TX)
+/*
+ * Virtual TX line of the host build
+ */
+uint8_t sHostIORegisters[0x40];
+uint8_t sHostTXBuffer[TINY_SERIAL_HOST_TX_BUFFER_SIZE];
+uint16_t sHostTXLength;
+uint32_t sHostTXFrameCount;
+uint64_t sHostTXCycles;
+
+void resetHostTX() {
+    sHostTXLength = 0;
+    sHostTXFrameCount = 0;
+    sHostTXCycles = 0;
+}
+
+void writeHostTXFrame(uint8_t aValue, uint16_t aFrameCycles) {
+    if (sHostTXLength < TINY_SERIAL_HOST_TX_BUFFER_SIZE) {
+        sHostTXBuffer[sHostTXLength++] = aValue;
+    }
+    sHostTXFrameCount++;
+    sHostTXCycles += aFrameCycles;
+}
+
+void write1Start8Data1StopNoParity(uint8_t aValue) {
+    writeHostTXFrame(aValue, TX_FRAME_CYCLES(TINY_SERIAL_BAUDRATE));
+    TX_STATISTICS_COUNT_FRAME
+}
+
+#elif defined(TINY_SERIAL_USE_TX_BUFFER)
+/*
+ * Interrupt driven output using a ring buffer.
+ * write1Start8Data1StopNoParity() only puts the byte into the buffer and starts the interrupt if required.
+ * The interrupt is generated by the timer (bit by bit) or by the USI (half frame by half frame).
+ * Each backend provides initTXBufferHardware(), isTXBufferInterruptActive(), startTXBufferInterrupt(),
+ * handleTXBufferInterrupt() and pollTXBufferInterruptIfInterruptsDisabled().
+ */
+volatile uint8_t sTXBuffer[TINY_SERIAL_TX_BUFFER_SIZE];
+volatile uint8_t sTXBufferHead; // Index of next free entry, only written by write1Start8Data1StopNoParity()
+volatile uint8_t sTXBufferTail; // Index of next byte to send, only written by ISR
+
+#  if !defined(TINY_SERIAL_USE_TIMER1_OC_TX) && !defined(TINY_SERIAL_USE_LIN_UART_TX)
+// Timer clock cycles per bit for the USI clock and the timer backend, rounded. The 8 bit timers use prescaler 8 above 256 cycles.
+#define TX_BUFFER_CYCLES_PER_BIT    ((F_CPU + (TINY_SERIAL_TX_BUFFER_BAUDRATE / 2)) / TINY_SERIAL_TX_BUFFER_BAUDRATE)
+#    if defined(TINY_SERIAL_USE_USI_TX) || defined(__AVR_ATtiny13__) || defined(__AVR_ATtiny13A__) \
+    || defined(__AVR_ATtiny25__) || defined(__AVR_ATtiny45__) || defined(__AVR_ATtiny85__)
+#      if (TX_BUFFER_CYCLES_PER_BIT > 2048)
+#error TINY_SERIAL_TX_BUFFER_BAUDRATE is too low for the 8 bit timer with prescaler 8.
+#      elif (TX_BUFFER_CYCLES_PER_BIT > 256)
+#define TX_BUFFER_PRESCALER         8
+#      endif
+#    endif
+#    if !defined(TX_BUFFER_PRESCALER)
+#define TX_BUFFER_PRESCALER         1
+#    endif
+// Compare value for CTC mode, rounded to the nearest timer period
+#define TX_BUFFER_TIMER_TOP         (((TX_BUFFER_CYCLES_PER_BIT + (TX_BUFFER_PRESCALER / 2)) / TX_BUFFER_PRESCALER) - 1)
+// The error of the 9 bits before the stop bit adds up
+#    if (TX_ABS_DIFF((TX_BUFFER_TIMER_TOP + 1) * TX_BUFFER_PRESCALER * TINY_SERIAL_TX_BUFFER_BAUDRATE, F_CPU) * 9 \
+    > (TINY_SERIAL_MAX_TIMING_ERROR_PERCENT * (F_CPU / 100)))
+#error Timing error for TINY_SERIAL_TX_BUFFER_BAUDRATE at F_CPU exceeds TINY_SERIAL_MAX_TIMING_ERROR_PERCENT.
+#    endif
+#  endif
+
+#  if defined(TINY_SERIAL_USE_USI_TX)
+/*
+ * The USI in three wire mode outputs the MSB of USIDR at the DO pin and is clocked by Timer0 compare match.
+ * Since USI shifts MSB first, the bytes are stored bit reversed in the buffer.
+ * A frame is sent in 2 parts, each ending with an overflow interrupt:
+ * First part:  1 (stop bit of previous frame), start bit, data bit 0 to 5 -> overflow after 6 shifts, when data bit 4 is at MSB.
+ * Second part: data bit 4 to 7, 4 stop bits -> overflow after 4 shifts, when stop bit is at MSB.
+ * If the buffer is then empty, the USI shifts once more and is disconnected after the stop bit is completely sent.
+ * Each reload starts with the bit which is currently output, so there is no glitch at DO,
+ * and since the old content contains the next bit too, an ISR delayed by almost one bit time does not corrupt the frame.
+ */
+#    if defined(__AVR_ATtiny25__) || defined(__AVR_ATtiny45__) || defined(__AVR_ATtiny85__)
+#      if defined(PIN_PB1)
+#        if TX_PIN != PIN_PB1
+#error TINY_SERIAL_USE_USI_TX requires TX_PIN to be the USI DO pin PIN_PB1.
+#        endif
+#      elif TX_PIN != PB1
+#error TINY_SERIAL_USE_USI_TX requires TX_PIN to be the USI DO pin PB1.
+#      endif
+#    elif defined(__AVR_ATtiny24__) || defined(__AVR_ATtiny44__) || defined(__AVR_ATtiny84__)
+#      if TX_PIN != PIN_PA5
+#error TINY_SERIAL_USE_USI_TX requires TX_PIN to be the USI DO pin PIN_PA5.
+#      endif
+#    else
+#error TINY_SERIAL_USE_USI_TX is only available for ATtiny25/45/85 and ATtiny24/44/84.
+#    endif
+
+#define USI_COUNTER_FOR_FIRST_PART  (16 - 6)
+#define USI_COUNTER_FOR_SECOND_PART (16 - 4)
+#define USI_COUNTER_FOR_STOP_BIT    (16 - 1)
+#define USI_LAST_STOP_BIT           0x01 // Value of sUSISecondPart, while the stop bit of the last frame is output
+
+volatile uint8_t sUSISecondPart; // 0 if first part of next frame must be loaded at next overflow
+
+/*
+ * Timer0 in CTC mode generates the USI clock
+ */
+void initTXBufferHardware() {
+    TCCR0A = _BV(WGM01); // CTC mode
+#    if (TX_BUFFER_PRESCALER == 8)
+    TCCR0B = _BV(CS01); // Prescaler 8
+#    else
+    TCCR0B = _BV(CS00); // No prescaling
+#    endif
+    OCR0A = TX_BUFFER_TIMER_TOP;
+    USICR = 0; // Disconnect USI from DO pin, which is then driven by the port register
+}
+
+inline bool isTXBufferInterruptActive() {
+    return USICR & _BV(USIOIE);
+}
+
+/*
+ * Loads the first part of the next frame from buffer. Returns false if buffer is empty.
+ * Is called when the stop bit is output.
+ */
+inline bool loadUSIFirstPart() {
+    uint8_t tTail = sTXBufferTail;
+    if (tTail == sTXBufferHead) {
+        return false;
+    }
+    uint8_t tReversedByte = sTXBuffer[tTail];
+    USIDR = 0x80 | (tReversedByte >> 2); // 1, start bit (0), data bit 0 to 5
+    USISR = _BV(USIOIF) | USI_COUNTER_FOR_FIRST_PART; // reset flag and set counter
+    sUSISecondPart = (tReversedByte << 4) | 0x0F; // data bit 4 to 7, stop bits
+    sTXBufferTail = (tTail + 1) & (TINY_SERIAL_TX_BUFFER_SIZE - 1);
+    return true;
+}
+
+/*
+ * Must be called with interrupts disabled
+ */
+inline void startTXBufferInterrupt() {
+    loadUSIFirstPart();
+    // Three wire mode, clock by Timer0 compare match, enable overflow interrupt
+    USICR = _BV(USIOIE) | _BV(USIWM0) | _BV(USICS0);
+}
+
+inline void handleTXBufferInterrupt() {
+    uint8_t tSecondPart = sUSISecondPart;
+    if (tSecondPart == USI_LAST_STOP_BIT) {
+        // Stop bit of the last frame is completely sent
+        sUSISecondPart = 0;
+        if (!loadUSIFirstPart()) {
+            // Buffer is still empty -> disconnect USI, the port register keeps the line at the stop level
+            USICR = 0;
+        }
+    } else if (tSecondPart != 0) {
+        USIDR = tSecondPart;
+        USISR = _BV(USIOIF) | USI_COUNTER_FOR_SECOND_PART;
+        sUSISecondPart = 0;
+    } else if (!loadUSIFirstPart()) {
+        // Buffer is empty -> shift out the stop bit for one more bit time, so that flushTXBuffer() returns after the stop bit
+        USISR = _BV(USIOIF) | USI_COUNTER_FOR_STOP_BIT;
+        sUSISecondPart = USI_LAST_STOP_BIT;
+    }
+}
+
+ISR(USI_OVF_vect) {
+    handleTXBufferInterrupt();
+}
+
+/*
+ * If we wait with interrupts disabled, e.g. in an ISR, we must do the job of the USI ISR here
+ */
+inline void pollTXBufferInterruptIfInterruptsDisabled() {
+    if (!(SREG & _BV(SREG_I)) && (USISR & _BV(USIOIF))) {
+        handleTXBufferInterrupt();
+    }
+}
+
+#  elif defined(TINY_SERIAL_USE_TIMER1_OC_TX)
+/*
+ * Timer1 in CTC mode with OCR1C as top generates one compare match per bit at OC1A or OC1B.
+ * The compare output mode is set or clear, and the ISR at each match selects the level for the next match.
+ * So the level of each bit is programmed one bit time in advance and an ISR delayed by up to one bit time does not corrupt the frame.
+ * In idle state the mode is set, which keeps the line HIGH at each match.
+ */
+#    if defined(PIN_PB1) && (TX_PIN == PIN_PB1) || !defined(PIN_PB1) && (TX_PIN == PB1)
+#define TX_OC_MODE_REGISTER         TCCR1
+#define TX_OC_MODE_SET_BIT          COM1A0
+#define TX_OC_MODE_SET              (_BV(COM1A1) | _BV(COM1A0))
+#define TX_OC_FORCE_BIT             FOC1A
+#define TX_OC_COMPARE_REGISTER      OCR1A
+#define TX_OC_TIMER_VECTOR          TIM1_COMPA_vect
+#define TX_OC_TIMER_FLAG_BIT        OCF1A
+#define TX_OC_TIMER_MASK_BIT        OCIE1A
+#    elif defined(PIN_PB4) && (TX_PIN == PIN_PB4) || !defined(PIN_PB4) && (TX_PIN == PB4)
+#define TX_OC_MODE_REGISTER         GTCCR
+#define TX_OC_MODE_SET_BIT          COM1B0
+#define TX_OC_MODE_SET              (_BV(COM1B1) | _BV(COM1B0))
+#define TX_OC_FORCE_BIT             FOC1B
+#define TX_OC_COMPARE_REGISTER      OCR1B
+#define TX_OC_TIMER_VECTOR          TIM1_COMPB_vect
+#define TX_OC_TIMER_FLAG_BIT        OCF1B
+#define TX_OC_TIMER_MASK_BIT        OCIE1B
+#    else
+#error TINY_SERIAL_USE_TIMER1_OC_TX requires TX_PIN to be OC1A (PB1) or OC1B (PB4).
+#    endif
+
+// Timer1 has all prescalers from 1 to 16384, choose the smallest one, which fits the bit time into 8 bit
+#define TX_BUFFER_CYCLES_PER_BIT    ((F_CPU + (TINY_SERIAL_TX_BUFFER_BAUDRATE / 2)) / TINY_SERIAL_TX_BUFFER_BAUDRATE)
+#    if (TX_BUFFER_CYCLES_PER_BIT <= 256)
+#define TX_OC_PRESCALER_SELECT      1
+#    elif (TX_BUFFER_CYCLES_PER_BIT <= 512)
+#define TX_OC_PRESCALER_SELECT      2
+#    elif (TX_BUFFER_CYCLES_PER_BIT <= 1024)
+#define TX_OC_PRESCALER_SELECT      3
+#    elif (TX_BUFFER_CYCLES_PER_BIT <= 2048)
+#define TX_OC_PRESCALER_SELECT      4
+#    elif (TX_BUFFER_CYCLES_PER_BIT <= 4096)
+#define TX_OC_PRESCALER_SELECT      5
+#    elif (TX_BUFFER_CYCLES_PER_BIT <= 8192)
+#define TX_OC_PRESCALER_SELECT      6
+#    elif (TX_BUFFER_CYCLES_PER_BIT <= 16384)
+#define TX_OC_PRESCALER_SELECT      7
+#    else
+#error TINY_SERIAL_TX_BUFFER_BAUDRATE is too low for F_CPU.
+#    endif
+// CS13:CS10 = n selects the prescaler 2^(n-1)
+#define TX_OC_PRESCALER             (1 << (TX_OC_PRESCALER_SELECT - 1))
+#define TX_OC_TIMER_TOP             (((TX_BUFFER_CYCLES_PER_BIT + (TX_OC_PRESCALER / 2)) / TX_OC_PRESCALER) - 1)
+
+/*
+ * Contains the levels still to program. LSB is the level for the next compare match.
+ * 0 means, that the stop bit is currently output and the next byte can be started.
+ * TX_OC_LAST_STOP_BIT means, that the buffer was empty at the start of the stop bit. Then the interrupt is disabled
+ * at the next compare match, when the stop bit is completely sent, so that flushTXBuffer() does not return before.
+ */
+#define TX_OC_LAST_STOP_BIT         0x8000
+volatile uint16_t sTXShiftRegister;
+
+/*
+ * Connects the compare output in set mode and forces it to HIGH, but does not enable the compare interrupt
+ */
+void initTXBufferHardware() {
+    OCR1C = TX_OC_TIMER_TOP;
+    TX_OC_COMPARE_REGISTER = TX_OC_TIMER_TOP;
+    TX_OC_MODE_REGISTER |= TX_OC_MODE_SET;
+    TCCR1 |= _BV(CTC1) | TX_OC_PRESCALER_SELECT;
+    GTCCR |= _BV(TX_OC_FORCE_BIT); // Output the set level now and not only at the next compare match
+}
+
+inline bool isTXBufferInterruptActive() {
+    return TIMSK & _BV(TX_OC_TIMER_MASK_BIT);
+}
+
+/*
+ * Must be called with interrupts disabled.
+ * The timer is running and the mode is set, so the line stays HIGH until the first interrupt programs the start bit.
+ */
+inline void startTXBufferInterrupt() {
+    sTXShiftRegister = 0;
+    TIFR = _BV(TX_OC_TIMER_FLAG_BIT);
+    TIMSK |= _BV(TX_OC_TIMER_MASK_BIT);
+}
+
+/*
+ * Is called at the compare match, which just output the previously programmed level
+ */
+inline void handleTXBufferInterrupt() {
+    uint16_t tShiftRegister = sTXShiftRegister;
+    if (tShiftRegister == 0 || tShiftRegister == TX_OC_LAST_STOP_BIT) {
+        // stop bit is now output or completely sent, get next byte from buffer
+        uint8_t tTail = sTXBufferTail;
+        if (tTail == sTXBufferHead) {
+            if (tShiftRegister == 0) {
+                // Buffer is empty -> wait for the end of the stop bit
+                sTXShiftRegister = TX_OC_LAST_STOP_BIT;
+            } else {
+                // Stop bit is completely sent -> stop interrupts, the mode is still set from the stop bit
+                TIMSK &= ~_BV(TX_OC_TIMER_MASK_BIT);
+            }
+            return;
+        }
+        tShiftRegister = (sTXBuffer[tTail] << 1) | 0x200; // add start (0) and stop bit (1)
+        sTXBufferTail = (tTail + 1) & (TINY_SERIAL_TX_BUFFER_SIZE - 1);
+    }
+    if (tShiftRegister & 0x01) {
+        TX_OC_MODE_REGISTER |= _BV(TX_OC_MODE_SET_BIT);
+    } else {
+        TX_OC_MODE_REGISTER &= ~_BV(TX_OC_MODE_SET_BIT); // clear mode
+    }
+    sTXShiftRegister = tShiftRegister >> 1;
+}
+
+ISR(TX_OC_TIMER_VECTOR) {
+    handleTXBufferInterrupt();
+}
+
+/*
+ * If we wait with interrupts disabled, e.g. in an ISR, we must do the job of the timer ISR here
+ */
+inline void pollTXBufferInterruptIfInterruptsDisabled() {
+    if (!(SREG & _BV(SREG_I)) && (TIFR & _BV(TX_OC_TIMER_FLAG_BIT))) {
+        TIFR = _BV(TX_OC_TIMER_FLAG_BIT); // reset flag by writing 1
+        handleTXBufferInterrupt();
+    }
+}
+
+#  elif defined(TINY_SERIAL_USE_LIN_UART_TX)
+/*
+ * The LIN/UART in UART mode sends the bytes, the transmit complete ISR loads the next byte from buffer.
+ * Baud rate is F_CPU / (LBT * (LDIV + 1)) with LBT (bit sampling) from 8 to 63 and LDIV (LINBRR) from 0 to 4095.
+ */
+/*
+ * The divider for aLBT, and the difference of the resulting bit time to the ideal one, in units of 1 / aBaudrate cycles.
+ * The relative error of a bit is then LIN_DIFFERENCE / F_CPU.
+ */
+#define LIN_DIVIDER(aBaudrate, aLBT)    ((F_CPU + (((aLBT) * (aBaudrate)) / 2)) / ((aLBT) * (aBaudrate)))
+#define LIN_DIFFERENCE(aBaudrate, aLBT) TX_ABS_DIFF((aLBT) * LIN_DIVIDER(aBaudrate, aLBT) * (aBaudrate), F_CPU)
+// The error of the 9 bits before the stop bit adds up
+#define LIN_MAX_DIFFERENCE              (TINY_SERIAL_MAX_TIMING_ERROR_PERCENT * (F_CPU / 900))
+
+/*
+ * Compile time version of the search in setLINUARTBaudrate(). Returns the least difference for LBT from aLBT to 63,
+ * or aBestDifference if it is smaller. 0xFFFFFFFF means, that no combination is possible.
+ */
+constexpr uint32_t LINUARTMinDifference(uint32_t aBaudrate, uint8_t aLBT, uint32_t aBestDifference) {
+    return (aLBT > 63 || LIN_DIVIDER(aBaudrate, aLBT) == 0) ? aBestDifference :
+            LINUARTMinDifference(aBaudrate, aLBT + 1,
+                    (LIN_DIVIDER(aBaudrate, aLBT) > 4096 || LIN_DIFFERENCE(aBaudrate, aLBT) >= aBestDifference) ?
+                            aBestDifference : LIN_DIFFERENCE(aBaudrate, aLBT));
+}
+static_assert(LINUARTMinDifference(TINY_SERIAL_TX_BUFFER_BAUDRATE, 8, 0xFFFFFFFF) <= LIN_MAX_DIFFERENCE,
+        "Timing error for TINY_SERIAL_TX_BUFFER_BAUDRATE at F_CPU exceeds TINY_SERIAL_MAX_TIMING_ERROR_PERCENT.");
+
+/*
+ * Chooses the LBT and LDIV combination with the least error.
+ * Returns false and keeps the current baud rate, if aBaudrate is 0 or the error at the stop bit exceeds TINY_SERIAL_MAX_TIMING_ERROR_PERCENT.
+ * Takes around 1 ms at 16 MHz, so call it only at setup.
+ */
+bool setLINUARTBaudrate(uint32_t aBaudrate) {
+    if (aBaudrate == 0) {
+        return false;
+    }
+    uint8_t tBestLBT = 8;
+    uint16_t tBestDivider = 1;
+    uint32_t tBestDifference = 0xFFFFFFFF;
+    for (uint8_t tLBT = 8; tLBT <= 63; ++tLBT) {
+        uint32_t tDivider = LIN_DIVIDER(aBaudrate, (uint32_t) tLBT);
+        if (tDivider == 0) {
+            break; // higher LBT values give even bigger errors
+        }
+        if (tDivider > 4096) {
+            continue;
+        }
+        uint32_t tDifference = LIN_DIFFERENCE(aBaudrate, (uint32_t) tLBT);
+        if (tDifference < tBestDifference) {
+            tBestDifference = tDifference;
+            tBestLBT = tLBT;
+            tBestDivider = tDivider;
+        }
+    }
+    if (tBestDifference > LIN_MAX_DIFFERENCE) {
+        return false;
+    }
+    flushTXBuffer();
+    LINCR = _BV(LSWRES); // reset LIN/UART, LBT can only be written if LENA is 0
+    LINBTR = _BV(LDISR) | tBestLBT;
+    LINBRR = tBestDivider - 1;
+    LINCR = _BV(LENA) | _BV(LCMD2) | _BV(LCMD0); // UART mode 8N1, TX only
+    return true;
+}
+
+void initTXBufferHardware() {
+    LINENIR = 0;
+    setLINUARTBaudrate(TINY_SERIAL_TX_BUFFER_BAUDRATE);
+}
+
+inline bool isTXBufferInterruptActive() {
+    return LINENIR & _BV(LENTXOK);
+}
+
+/*
+ * Must be called with interrupts disabled and buffer not empty
+ */
+inline void startTXBufferInterrupt() {
+    uint8_t tTail = sTXBufferTail;
+    LINDAT = sTXBuffer[tTail];
+    sTXBufferTail = (tTail + 1) & (TINY_SERIAL_TX_BUFFER_SIZE - 1);
+    LINENIR = _BV(LENTXOK);
+}
+
+inline void handleTXBufferInterrupt() {
+    LINSIR = _BV(LTXOK); // reset flag by writing 1
+    uint8_t tTail = sTXBufferTail;
+    if (tTail == sTXBufferHead) {
+        // Buffer is empty and last byte is completely sent
+        LINENIR = 0;
+    } else {
+        LINDAT = sTXBuffer[tTail];
+        sTXBufferTail = (tTail + 1) & (TINY_SERIAL_TX_BUFFER_SIZE - 1);
+    }
+}
+
+ISR(LIN_TC_vect) {
+    handleTXBufferInterrupt();
+}
+
+/*
+ * If we wait with interrupts disabled, e.g. in an ISR, we must do the job of the LIN ISR here
+ */
+inline void pollTXBufferInterruptIfInterruptsDisabled() {
+    if (!(SREG & _BV(SREG_I)) && (LINSIR & _BV(LTXOK))) {
+        handleTXBufferInterrupt();
+    }
+}
+
+#  else // defined(TINY_SERIAL_USE_USI_TX)
+/*
+ * The timer compare ISR outputs one bit per interrupt, so the bit timing is independent of the code running in the foreground.
+ * The ISR outputs the bit first and computes the next bit afterwards, to have a constant latency for each bit.
+ * Timing jitter is only caused by other ISRs or cli() sections, which delay our ISR.
+ */
+#    if defined(__AVR_ATtiny13__) || defined(__AVR_ATtiny13A__)
+#define TX_BUFFER_TIMER_VECTOR          TIM0_COMPA_vect
+#define TX_BUFFER_TIMER_COUNTER         TCNT0
+#define TX_BUFFER_TIMER_FLAG_REGISTER   TIFR0
+#define TX_BUFFER_TIMER_FLAG_BIT        OCF0A
+#define TX_BUFFER_TIMER_MASK_REGISTER   TIMSK0
+#define TX_BUFFER_TIMER_MASK_BIT        OCIE0A
+#    elif defined(__AVR_ATtiny25__) || defined(__AVR_ATtiny45__) || defined(__AVR_ATtiny85__)
+#define TX_BUFFER_TIMER_VECTOR          TIM1_COMPA_vect
+#define TX_BUFFER_TIMER_COUNTER         TCNT1
+#define TX_BUFFER_TIMER_FLAG_REGISTER   TIFR
+#define TX_BUFFER_TIMER_FLAG_BIT        OCF1A
+#define TX_BUFFER_TIMER_MASK_REGISTER   TIMSK
+#define TX_BUFFER_TIMER_MASK_BIT        OCIE1A
+#    elif defined(__AVR_ATtiny24__) || defined(__AVR_ATtiny44__) || defined(__AVR_ATtiny84__)
+#define TX_BUFFER_TIMER_VECTOR          TIM1_COMPA_vect
+#define TX_BUFFER_TIMER_COUNTER         TCNT1
+#define TX_BUFFER_TIMER_FLAG_REGISTER   TIFR1
+#define TX_BUFFER_TIMER_FLAG_BIT        OCF1A
+#define TX_BUFFER_TIMER_MASK_REGISTER   TIMSK1
+#define TX_BUFFER_TIMER_MASK_BIT        OCIE1A
+#    else // ATtiny87, ATtiny167, ATtiny88
+#define TX_BUFFER_TIMER_VECTOR          TIMER1_COMPA_vect
+#define TX_BUFFER_TIMER_COUNTER         TCNT1
+#define TX_BUFFER_TIMER_FLAG_REGISTER   TIFR1
+#define TX_BUFFER_TIMER_FLAG_BIT        OCF1A
+#define TX_BUFFER_TIMER_MASK_REGISTER   TIMSK1
+#define TX_BUFFER_TIMER_MASK_BIT        OCIE1A
+#    endif
+
+/*
+ * Contains the bits still to send. LSB is the bit to output at next interrupt.
+ * Start bit is bit 0, stop bit is bit 9. If register is 0 at an interrupt, the stop bit of the last byte is completely sent.
+ */
+volatile uint16_t sTXShiftRegister;
+
+/*
+ * Sets timer to CTC mode with TX_BUFFER_CYCLES_PER_BIT, but does not enable the compare interrupt
+ */
+void initTXBufferHardware() {
+#    if defined(__AVR_ATtiny13__) || defined(__AVR_ATtiny13A__)
+    TCCR0A = _BV(WGM01); // CTC mode
+#      if (TX_BUFFER_PRESCALER == 8)
+    TCCR0B = _BV(CS01); // Prescaler 8
+#      else
+    TCCR0B = _BV(CS00); // No prescaling
+#      endif
+    OCR0A = TX_BUFFER_TIMER_TOP;
+
+#    elif defined(__AVR_ATtiny25__) || defined(__AVR_ATtiny45__) || defined(__AVR_ATtiny85__)
+    // Timer1 is cleared at OCR1C match, interrupt is generated at OCR1A match
+#      if (TX_BUFFER_PRESCALER == 8)
+    TCCR1 = _BV(CTC1) | _BV(CS12); // Prescaler 8
+#      else
+    TCCR1 = _BV(CTC1) | _BV(CS10); // No prescaling
+#      endif
+    OCR1C = TX_BUFFER_TIMER_TOP;
+    OCR1A = TX_BUFFER_TIMER_TOP;
+
+#    else // 16 bit Timer1 of ATtiny84, ATtiny87, ATtiny167, ATtiny88
+    TCCR1A = 0;
+    TCCR1B = _BV(WGM12) | _BV(CS10); // CTC mode with OCR1A as top, no prescaling
+    OCR1A = TX_BUFFER_TIMER_TOP;
+#    endif
+}
+
+inline bool isTXBufferInterruptActive() {
+    return TX_BUFFER_TIMER_MASK_REGISTER & _BV(TX_BUFFER_TIMER_MASK_BIT);
+}
+
+/*
+ * Must be called with interrupts disabled.
+ * Start with one idle bit, at whose interrupt the first byte is loaded from buffer.
+ */
+inline void startTXBufferInterrupt() {
+    sTXShiftRegister = 0x01;
+    TX_BUFFER_TIMER_COUNTER = 0;
+    TX_BUFFER_TIMER_FLAG_REGISTER = _BV(TX_BUFFER_TIMER_FLAG_BIT);
+    TX_BUFFER_TIMER_MASK_REGISTER |= _BV(TX_BUFFER_TIMER_MASK_BIT);
+}
+
+/*
+ * Outputs the current bit and prepares the next one
+ */
+inline void handleTXBufferInterrupt() {
+    uint16_t tShiftRegister = sTXShiftRegister;
+    if (tShiftRegister == 0) {
+        // Buffer was empty after the last stop bit, which is now completely sent -> stop interrupts
+        TX_BUFFER_TIMER_MASK_REGISTER &= ~_BV(TX_BUFFER_TIMER_MASK_BIT);
+        return;
+    }
+    if (tShiftRegister & 0x01) {
+        TX_PORT |= (1 << TX_BIT_NUMBER);
+    } else {
+        TX_PORT &= ~(1 << TX_BIT_NUMBER);
+    }
+    tShiftRegister >>= 1;
+    if (tShiftRegister == 0) {
+        // stop bit was just output, get next byte from buffer
+        uint8_t tTail = sTXBufferTail;
+        if (tTail != sTXBufferHead) {
+            tShiftRegister = (sTXBuffer[tTail] << 1) | 0x200; // add start (0) and stop bit (1)
+            sTXBufferTail = (tTail + 1) & (TINY_SERIAL_TX_BUFFER_SIZE - 1);
+        }
+    }
+    sTXShiftRegister = tShiftRegister;
+}
+
+ISR(TX_BUFFER_TIMER_VECTOR) {
+    handleTXBufferInterrupt();
+}
+
+/*
+ * If we wait with interrupts disabled, e.g. in an ISR, we must do the job of the timer ISR here
+ */
+inline void pollTXBufferInterruptIfInterruptsDisabled() {
+    if (!(SREG & _BV(SREG_I)) && (TX_BUFFER_TIMER_FLAG_REGISTER & _BV(TX_BUFFER_TIMER_FLAG_BIT))) {
+        TX_BUFFER_TIMER_FLAG_REGISTER = _BV(TX_BUFFER_TIMER_FLAG_BIT); // reset flag by writing 1
+        handleTXBufferInterrupt();
+    }
+}
+#  endif // defined(TINY_SERIAL_USE_USI_TX)
+
+/*
+ * Estimated cycles per byte, in which the CPU is awake with TINY_SERIAL_SLEEP_WHILE_WAITING.
+ * The ISR cycles include prologue, epilogue and wake up, the 40 cycles are for write1Start8Data1StopNoParity().
+ */
+#  if defined(TINY_SERIAL_USE_USI_TX)
+#define TX_BUFFER_AWAKE_CYCLES_PER_BYTE     (2 * 65 + 40)   // 2 ISR per byte
+#  elif defined(TINY_SERIAL_USE_LIN_UART_TX)
+#define TX_BUFFER_AWAKE_CYCLES_PER_BYTE     (55 + 40)       // 1 ISR per byte
+#  elif defined(TINY_SERIAL_USE_TIMER1_OC_TX)
+#define TX_BUFFER_AWAKE_CYCLES_PER_BYTE     (10 * 60 + 40)  // 1 ISR per bit
+#  else
+#define TX_BUFFER_AWAKE_CYCLES_PER_BYTE     (10 * 70 + 40)  // 1 ISR per bit
+#  endif
+
+#  if defined(TINY_SERIAL_SLEEP_WHILE_WAITING)
+/*
+ * Enters idle sleep, if interrupts are enabled and the TX interrupt is active. The next interrupt wakes up the CPU.
+ * The instruction after sei() is executed before any pending interrupt, so the ISR cannot stop the TX interrupt
+ * between the check and sleep_cpu(), which would let us sleep forever.
+ */
+inline void sleepWhileTXBufferInterruptIsActive() {
+    if (SREG & _BV(SREG_I)) {
+        cli();
+        if (isTXBufferInterruptActive()) {
+            set_sleep_mode(SLEEP_MODE_IDLE);
+            sleep_enable();
+            sei();
+            sleep_cpu();
+            sleep_disable();
+        }
+        sei();
+    }
+}
+#  endif
+
+/*
+ * Puts byte into buffer and starts interrupt, if not already running.
+ * Waits if buffer is full.
+ */
+void write1Start8Data1StopNoParity(uint8_t aValue) {
+#  if defined(TINY_SERIAL_USE_USI_TX)
+    // Reverse bits here, since the ISR has no time for it
+    uint8_t tReversedValue = 0;
+    for (uint_fast8_t i = 0; i < 8; ++i) {
+        tReversedValue <<= 1;
+        if (aValue & 0x01) {
+            tReversedValue |= 0x01;
+        }
+        aValue >>= 1;
+    }
+    aValue = tReversedValue;
+#  endif
+    uint8_t tHead = sTXBufferHead;
+    uint8_t tNextHead = (tHead + 1) & (TINY_SERIAL_TX_BUFFER_SIZE - 1);
+    while (tNextHead == sTXBufferTail) {
+        // Buffer is full -> wait for the ISR to send the next byte
+        pollTXBufferInterruptIfInterruptsDisabled();
+#  if defined(TINY_SERIAL_SLEEP_WHILE_WAITING)
+        sleepWhileTXBufferInterruptIsActive();
+#  endif
+    }
+    sTXBuffer[tHead] = aValue;
+
+    uint8_t oldSREG = SREG;
+    cli();
+    sTXBufferHead = tNextHead;
+    if (!isTXBufferInterruptActive()) {
+        startTXBufferInterrupt();
+    }
+    SREG = oldSREG;
+    TX_STATISTICS_COUNT_FRAME
+}
+
+/*
+ * Waits until the buffer is empty and the stop bit of the last byte is sent
+ */
+void flushTXBuffer() {
+    while (isTXBufferInterruptActive()) {
+        pollTXBufferInterruptIfInterruptsDisabled();
+#  if defined(TINY_SERIAL_SLEEP_WHILE_WAITING)
+        sleepWhileTXBufferInterruptIsActive();
+#  endif
+    }
+}
+
+#elif defined(TINY_SERIAL_RUNTIME_BAUDRATE)
+/*
+ * Timing values for one baud rate, see TX_RUNTIME_* macros
+ */
+struct TXBaudrateTiming {
+    uint16_t BaudrateDiv100;
+    uint16_t StartDelayCount;
+    uint16_t DataDelayCount;
+    uint16_t StopDelayCount;
+    uint8_t Flags;
+};
+
+const TXBaudrateTiming sTXBaudrateTimings[] PROGMEM = {
+#if TX_RUNTIME_IS_POSSIBLE(1200)
+        TX_RUNTIME_TIMING(1200),
+#endif
+#if TX_RUNTIME_IS_POSSIBLE(2400)
+        TX_RUNTIME_TIMING(2400),
+#endif
+#if TX_RUNTIME_IS_POSSIBLE(4800)
+        TX_RUNTIME_TIMING(4800),
+#endif
+#if TX_RUNTIME_IS_POSSIBLE(9600)
+        TX_RUNTIME_TIMING(9600),
+#endif
+#if TX_RUNTIME_IS_POSSIBLE(14400)
+        TX_RUNTIME_TIMING(14400),
+#endif
+#if TX_RUNTIME_IS_POSSIBLE(19200)
+        TX_RUNTIME_TIMING(19200),
+#endif
+#if TX_RUNTIME_IS_POSSIBLE(28800)
+        TX_RUNTIME_TIMING(28800),
+#endif
+#if TX_RUNTIME_IS_POSSIBLE(38400)
+        TX_RUNTIME_TIMING(38400),
+#endif
+#if TX_RUNTIME_IS_POSSIBLE(57600)
+        TX_RUNTIME_TIMING(57600),
+#endif
+#if TX_RUNTIME_IS_POSSIBLE(76800)
+        TX_RUNTIME_TIMING(76800),
+#endif
+#if TX_RUNTIME_IS_POSSIBLE(115200)
+        TX_RUNTIME_TIMING(115200),
+#endif
+#if TX_RUNTIME_IS_POSSIBLE(230400)
+        TX_RUNTIME_TIMING(230400),
+#endif
+#if TX_RUNTIME_IS_POSSIBLE(250000)
+        TX_RUNTIME_TIMING(250000),
+#endif
+#if TX_RUNTIME_IS_POSSIBLE(500000)
+        TX_RUNTIME_TIMING(500000),
+#endif
+        };
+
+TXBaudrateTiming sTXBaudrateTiming = TX_RUNTIME_TIMING(TINY_SERIAL_BAUDRATE);
+#  if defined(TINY_SERIAL_STATISTICS)
+uint16_t sTXStatisticsFrameCycles = TX_FRAME_CYCLES(TINY_SERIAL_BAUDRATE);
+#  endif
+
+/*
+ * Copies the timing for aBaudrate from the table in FLASH to RAM
+ * @return false and keep the current timing, if aBaudrate is not in the table
+ */
+bool setTXBaudrate(uint32_t aBaudrate) {
+    if (aBaudrate % 100 != 0) {
+        return false;
+    }
+    uint16_t tBaudrateDiv100 = aBaudrate / 100;
+    for (uint8_t i = 0; i < sizeof(sTXBaudrateTimings) / sizeof(TXBaudrateTiming); ++i) {
+        if (pgm_read_word(&sTXBaudrateTimings[i].BaudrateDiv100) == tBaudrateDiv100) {
+            memcpy_P(&sTXBaudrateTiming, &sTXBaudrateTimings[i], sizeof(TXBaudrateTiming));
+#  if defined(TINY_SERIAL_STATISTICS)
+            sTXStatisticsFrameCycles = (10 * F_CPU + aBaudrate / 2) / aBaudrate;
+#  endif
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Loop kernel with delay counts and paddings taken from sTXBaudrateTiming.
+ * The paddings are realized by skipping 3 or 4 cycles instructions depending on the bits of the flags.
+ * The alternating of data bit length is realized by toggling bit 2 of r26 with r27, which is 0 if not alternating.
+ * Code size is around 70 bytes, plus the table.
+ *
+ * 2 cycles for each cbi/sbi instruction.
+ */
+void write1Start8Data1StopNoParity(uint8_t aValue) {
+    asm volatile
+    (
+            "cbi  %[txport] , %[txpin]" "\n\t" // 2    PORTB &= ~(1 << TX_BIT_NUMBER);
+            "clr  r26" "\n\t"// 1    alternate toggle
+            "mov  r27 , %[flags]" "\n\t"// 1
+            "andi r27 , 0x04" "\n\t"// 1    alternate mask
+            "sbrc %[flags] , 4" "\n\t"// 2 for flag bit cleared, 1 for set
+            "rjmp .+0" "\n\t"// 2    -> + 1 cycle for flag bit 4
+            "sbrc %[flags] , 5" "\n\t"// 2 for flag bit cleared, 1 for set
+            "lpm" "\n\t"// 3    -> + 2 cycles for flag bit 5, only r0 (__tmp_reg__) is changed
+            "movw r30 , %[startCount]" "\n\t"// 1
+            "L%=delay1:"
+            "sbiw r30 , 0x01" "\n\t"// 2
+            "brne L%=delay1" "\n\t"// 1-2
+
+            "ldi r25 , 0x08" "\n\t"// 1
+
+            // Start of loop
+            // if (aValue & 0x01) {
+            "L%=txloop:"
+            "sbrs %[value] , 0" "\n\t"// 1
+            "rjmp .+6" "\n\t"// 2
+
+            "nop" "\n\t"// 1
+            "sbi %[txport] , %[txpin]" "\n\t"// 2    PORTB |= 1 << TX_BIT_NUMBER;
+            "rjmp .+6" "\n\t"// 2
+
+            "cbi %[txport] , %[txpin]" "\n\t"// 2    PORTB &= ~(1 << TX_BIT_NUMBER);
+            "nop" "\n\t"// 1
+            "nop" "\n\t"// 1
+            "lsr %[value]" "\n\t"// 1    aValue = aValue >> 1;
+
+            "sbrc r26 , 2" "\n\t"// 2 for bit 0, 2, 4, 6 and 1 for bit 1, 3, 5, 7 if alternating
+            "rjmp .+0" "\n\t"// 2
+            "eor r26 , r27" "\n\t"// 1
+            "sbrc %[flags] , 0" "\n\t"// 2 for flag bit cleared, 1 for set
+            "rjmp .+0" "\n\t"// 2    -> + 1 cycle for flag bit 0
+            "sbrc %[flags] , 1" "\n\t"// 2 for flag bit cleared, 1 for set
+            "lpm" "\n\t"// 3    -> + 2 cycles for flag bit 1
+            "movw r30 , %[dataCount]" "\n\t"// 1
+            "L%=delay2:"
+            "sbiw r30 , 0x01" "\n\t"// 2
+            "brne L%=delay2" "\n\t"// 1-2
+
+            // }while (i > 0);
+            "subi r25 , 0x01" "\n\t"// 1
+            "brne L%=txloop" "\n\t"// 1-2
+            // To compensate for missing loop cycles at last bit
+            "nop" "\n\t"// 1
+            "nop" "\n\t"// 1
+            "nop" "\n\t"// 1
+            "nop" "\n\t"// 1
+
+            // Stop bit
+            "sbi %[txport] , %[txpin]" "\n\t"// 2    PORTB |= 1 << TX_BIT_NUMBER;
+            "movw r30 , %[stopCount]" "\n\t"// 1
+            "L%=delay3:"
+            "sbiw r30 , 0x01" "\n\t"// 2
+            "brne L%=delay3" "\n\t"// 1-2
+            // return needs 4 cycles, load of next value needs 1 cycle, next rcall needs 3 cycles -> gives additional 8 cycles minimum for stop bit
+            // Loading of the timing values at the next call adds some more cycles for stop bit
+
+            :
+            [value] "+r" ( aValue )
+            :
+            [txport] "I" ( TX_PORT_ADDR ),
+            [txpin] "I" ( TX_BIT_NUMBER ),
+            [flags] "r" ( sTXBaudrateTiming.Flags ),
+            [startCount] "r" ( sTXBaudrateTiming.StartDelayCount ), // movw requires an even register pair, which is always the case for 16 bit values
+            [dataCount] "r" ( sTXBaudrateTiming.DataDelayCount ),
+            [stopCount] "r" ( sTXBaudrateTiming.StopDelayCount )
+            :
+            "r25",
+            "r26",
+            "r27",
+            "r30",
+            "r31"
+    );
+    TX_STATISTICS_COUNT_FRAME
+}
+
+#elif TX_USE_UNROLLED_KERNEL && defined(TINY_SERIAL_USE_TURBO_KERNEL)
+/*
+ * Unrolled turbo kernel for less than 20 cycles per bit e.g. 2 Mbaud at 16 MHz or 1 Mbaud at 8 MHz.
+ * Port value is read once, and each bit is then copied with bst/bld to this value, which is written with out.
+ * This requires only 3 cycles per bit, but overwrites all other bits of the port during the frame.
+ * So changes of other pins of the TX port by an ISR are lost, if interrupts are not disabled during write.
+ * Padding cycles are realized by rjmp .+0, which saves half of the nops of the unrolled kernel.
+ * Code size is 62 byte without padding.
+ */
+void write1Start8Data1StopNoParity(uint8_t aValue) {
+    asm volatile
+    (
+            "in    r26, %[txport]" "\n\t" /* 1 */
+            "mov   r27, r26" "\n\t" /* 1 */
+            "ori   r27, %[txmask]" "\n\t" /* 1  port value for stop bit */
+            "andi  r26, lo8(~%[txmask])" "\n\t" /* 1  port value for start bit */
+            "out   %[txport], r26" "\n\t" /* 1  <--- start bit edge */
+            ".rept %[pad0] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad0 */
+            ".rept %[pad0] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   %[value], 0" "\n\t" /* 1 */
+            "bld   r26, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r26" "\n\t" /* 1  <--- st is 3 + pad0 cycles */
+            ".rept %[pad1] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad1 */
+            ".rept %[pad1] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   %[value], 1" "\n\t" /* 1 */
+            "bld   r26, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r26" "\n\t" /* 1  <--- b0 is 3 + pad1 cycles */
+            ".rept %[pad2] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad2 */
+            ".rept %[pad2] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   %[value], 2" "\n\t" /* 1 */
+            "bld   r26, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r26" "\n\t" /* 1  <--- b1 is 3 + pad2 cycles */
+            ".rept %[pad3] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad3 */
+            ".rept %[pad3] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   %[value], 3" "\n\t" /* 1 */
+            "bld   r26, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r26" "\n\t" /* 1  <--- b2 is 3 + pad3 cycles */
+            ".rept %[pad4] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad4 */
+            ".rept %[pad4] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   %[value], 4" "\n\t" /* 1 */
+            "bld   r26, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r26" "\n\t" /* 1  <--- b3 is 3 + pad4 cycles */
+            ".rept %[pad5] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad5 */
+            ".rept %[pad5] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   %[value], 5" "\n\t" /* 1 */
+            "bld   r26, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r26" "\n\t" /* 1  <--- b4 is 3 + pad5 cycles */
+            ".rept %[pad6] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad6 */
+            ".rept %[pad6] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   %[value], 6" "\n\t" /* 1 */
+            "bld   r26, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r26" "\n\t" /* 1  <--- b5 is 3 + pad6 cycles */
+            ".rept %[pad7] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad7 */
+            ".rept %[pad7] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   %[value], 7" "\n\t" /* 1 */
+            "bld   r26, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r26" "\n\t" /* 1  <--- b6 is 3 + pad7 cycles */
+            ".rept %[pad8] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad8 */
+            ".rept %[pad8] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "out   %[txport], r27" "\n\t" /* 1  <--- b7 is 1 + pad8 cycles */
+            ".rept %[padStop] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* padStop */
+            ".rept %[padStop] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+            /*    <---sp is at least cycles per bit including ret and next call */
+
+            :
+            :
+            [value] "r" ( aValue ),
+            [txport] "I" ( TX_PORT_ADDR ),
+            [txpin] "I" ( TX_BIT_NUMBER ),
+            [txmask] "M" ( 1 << TX_BIT_NUMBER ),
+            [pad0] "i" ( TX_TURBO_PADDING_CYCLES(0) ),
+            [pad1] "i" ( TX_TURBO_PADDING_CYCLES(1) ),
+            [pad2] "i" ( TX_TURBO_PADDING_CYCLES(2) ),
+            [pad3] "i" ( TX_TURBO_PADDING_CYCLES(3) ),
+            [pad4] "i" ( TX_TURBO_PADDING_CYCLES(4) ),
+            [pad5] "i" ( TX_TURBO_PADDING_CYCLES(5) ),
+            [pad6] "i" ( TX_TURBO_PADDING_CYCLES(6) ),
+            [pad7] "i" ( TX_TURBO_PADDING_CYCLES(7) ),
+            [pad8] "i" ( TX_TURBO_PADDING_CYCLES(8) ),
+            [padStop] "i" ( TX_TURBO_STOP_PADDING_CYCLES )
+            :
+            "r26",
+            "r27"
+    );
+    TX_STATISTICS_COUNT_FRAME
+}
+
+#  if defined(TX_USE_STREAM_KERNEL)
+/*
+ * Port values for start and stop bit in r26 and r27
+ */
+#define TX_TURBO_PORT_VALUES_ASM \
+    "in    r26, %[txport]" "\n\t" /* 1 */ \
+    "mov   r27, r26" "\n\t" /* 1 */ \
+    "ori   r27, %[txmask]" "\n\t" /* 1  port value for stop bit */ \
+    "andi  r26, lo8(~%[txmask])" "\n\t" /* 1  port value for start bit */
+
+/*
+ * Streaming version of the turbo kernel. Interrupts are disabled during each chunk of sStreamChunkLength frames.
+ * Port values for start and stop bit are read at the beginning of the stream and again after each interrupt window,
+ * so changes of other pins of the TX port by an ISR are not overwritten. This prolongs the window to 11 cycles.
+ * The next byte is fetched into r22 during the stop bit, Z is the pointer.
+ */
+template<uint8_t tSource, bool tIsString> void writeStream(const uint8_t *aPointer, uint8_t aLength, bool aDisableInterrupts) {
+    TX_STATISTICS_STREAM_START
+    asm volatile
+    (
+            TX_STREAM_START_ASM
+            TX_STREAM_DICTIONARY_INIT_ASM
+            TX_TURBO_PORT_VALUES_ASM
+            TX_STREAM_FIRST_FETCH_ASM
+
+            "L%=frame:"
+            "mov   r25, r26" "\n\t" /* 1 */
+            "out   %[txport], r26" "\n\t" /* 1  <--- start bit edge */
+            ".rept %[pad0] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad0 */
+            ".rept %[pad0] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   r22, 0" "\n\t" /* 1 */
+            "bld   r25, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r25" "\n\t" /* 1  <--- st is 3 + pad0 cycles */
+            ".rept %[pad1] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad1 */
+            ".rept %[pad1] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   r22, 1" "\n\t" /* 1 */
+            "bld   r25, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r25" "\n\t" /* 1  <--- b0 is 3 + pad1 cycles */
+            ".rept %[pad2] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad2 */
+            ".rept %[pad2] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   r22, 2" "\n\t" /* 1 */
+            "bld   r25, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r25" "\n\t" /* 1  <--- b1 is 3 + pad2 cycles */
+            ".rept %[pad3] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad3 */
+            ".rept %[pad3] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   r22, 3" "\n\t" /* 1 */
+            "bld   r25, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r25" "\n\t" /* 1  <--- b2 is 3 + pad3 cycles */
+            ".rept %[pad4] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad4 */
+            ".rept %[pad4] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   r22, 4" "\n\t" /* 1 */
+            "bld   r25, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r25" "\n\t" /* 1  <--- b3 is 3 + pad4 cycles */
+            ".rept %[pad5] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad5 */
+            ".rept %[pad5] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   r22, 5" "\n\t" /* 1 */
+            "bld   r25, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r25" "\n\t" /* 1  <--- b4 is 3 + pad5 cycles */
+            ".rept %[pad6] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad6 */
+            ".rept %[pad6] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   r22, 6" "\n\t" /* 1 */
+            "bld   r25, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r25" "\n\t" /* 1  <--- b5 is 3 + pad6 cycles */
+            ".rept %[pad7] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad7 */
+            ".rept %[pad7] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "bst   r22, 7" "\n\t" /* 1 */
+            "bld   r25, %[txpin]" "\n\t" /* 1 */
+            "out   %[txport], r25" "\n\t" /* 1  <--- b6 is 3 + pad7 cycles */
+            ".rept %[pad8] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t" /* pad8 */
+            ".rept %[pad8] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+
+            "out   %[txport], r27" "\n\t" /* 1  <--- b7 is 1 + pad8 cycles */
+            TX_STREAM_CHUNK_ASM
+            TX_STREAM_NEXT_ASM
+            ".rept %[gapPad] / 2" "\n\t" "rjmp  .+0" "\n\t" ".endr" "\n\t"
+            ".rept %[gapPad] %% 2" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+            "rjmp  L%=frame" "\n\t" /* 2  <--- sp is 6 + next + gapPad cycles including mov */
+
+            TX_STREAM_INTERRUPT_WINDOW_ASM(TX_TURBO_PORT_VALUES_ASM)
+
+            "L%=end:"
+            "out   __SREG__, __tmp_reg__" "\n\t"
+            "ldi   r24, lo8(%[stopCount])" "\n\t"
+            "ldi   r25, hi8(%[stopCount])" "\n\t"
+            "L%=delay:"
+            "sbiw  r24, 0x01" "\n\t"
+            "brne  L%=delay" "\n\t"
+            "L%=exit:"
+
+            :
+            [pointer] "+z" ( aPointer ),
+            [length] "+r" ( aLength )
+            :
+            TX_STREAM_OPERANDS(tSource, tIsString),
+            [txmask] "M" ( 1 << TX_BIT_NUMBER ),
+            [pad0] "i" ( TX_TURBO_PADDING_CYCLES(0) ),
+            [pad1] "i" ( TX_TURBO_PADDING_CYCLES(1) ),
+            [pad2] "i" ( TX_TURBO_PADDING_CYCLES(2) ),
+            [pad3] "i" ( TX_TURBO_PADDING_CYCLES(3) ),
+            [pad4] "i" ( TX_TURBO_PADDING_CYCLES(4) ),
+            [pad5] "i" ( TX_TURBO_PADDING_CYCLES(5) ),
+            [pad6] "i" ( TX_TURBO_PADDING_CYCLES(6) ),
+            [pad7] "i" ( TX_TURBO_PADDING_CYCLES(7) ),
+            [pad8] "i" ( TX_TURBO_PADDING_CYCLES(8) ),
+            [gapPad] "i" ( TX_STREAM_PADDING_CYCLES(tSource, tIsString) )
+            :
+            "r18",
+            "r19",
+            "r20",
+            "r21",
+            "r22",
+            "r24",
+            "r25",
+            "r26",
+            "r27"
+    );
+    TX_STATISTICS_STREAM_END
+}
+#  endif // defined(TX_USE_STREAM_KERNEL)
+
+#elif TX_USE_UNROLLED_KERNEL
+/*
+ * Unrolled kernel for less than 20 cycles per bit e.g. 115200 baud at 1 MHz - 8,680 cycles per bit, 86,8 per byte.
+ * The padding nops are computed by the timing generator, which gives 9, 8, 9, 9, 8, 9, 9, 8, 9 cycles at 1 MHz.
+ *
+ *  Assembler code for 115200 baud extracted from Digispark core files:
+ *  Code size is 196 byte (including first call)
+ *
+ *   TinySerialOut.h - Tiny write-only software serial.
+ *   Copyright 2010 Rowdy Dog Software. This code is part of Arduino-Tiny.
+ *
+ *   Arduino-Tiny is free software: you can redistribute it and/or modify it
+ *   under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or (at your
+ *   option) any later version.
+ */
+void write1Start8Data1StopNoParity(uint8_t aValue) {
+    asm volatile
+    (
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- 0 */
+            "ror   %[value]" "\n\t" /* 1 */
+            ".rept %[pad0]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad0 */
+
+            "brcs  L%=b0h" "\n\t" /* 1  (not taken) */
+            "nop" "\n\t" /* 1 */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- st is 5 + pad0 cycles */
+            "rjmp  L%=b0z" "\n\t" /* 2 */
+            "L%=b0h: " /* 2  (taken) */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- st is 5 + pad0 cycles */
+            "nop" "\n\t" /* 1 */
+            "nop" "\n\t" /* 1 */
+            "L%=b0z: "
+            "ror   %[value]" "\n\t" /* 1 */
+            ".rept %[pad1]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad1 */
+
+            "brcs  L%=b1h" "\n\t" /* 1  (not taken) */
+            "nop" "\n\t" /* 1 */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b0 is 7 + pad1 cycles */
+            "rjmp  L%=b1z" "\n\t" /* 2 */
+            "L%=b1h: " /* 2  (taken) */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b0 is 7 + pad1 cycles */
+            "nop" "\n\t" /* 1 */
+            "nop" "\n\t" /* 1 */
+            "L%=b1z: "
+            "ror   %[value]" "\n\t" /* 1 */
+            ".rept %[pad2]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad2 */
+
+            "brcs  L%=b2h" "\n\t" /* 1  (not taken) */
+            "nop" "\n\t" /* 1 */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b1 is 7 + pad2 cycles */
+            "rjmp  L%=b2z" "\n\t" /* 2 */
+            "L%=b2h: " /* 2  (taken) */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b1 is 7 + pad2 cycles */
+            "nop" "\n\t" /* 1 */
+            "nop" "\n\t" /* 1 */
+            "L%=b2z: "
+            "ror   %[value]" "\n\t" /* 1 */
+            ".rept %[pad3]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad3 */
+
+            "brcs  L%=b3h" "\n\t" /* 1  (not taken) */
+            "nop" "\n\t" /* 1 */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b2 is 7 + pad3 cycles */
+            "rjmp  L%=b3z" "\n\t" /* 2 */
+            "L%=b3h: " /* 2  (taken) */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b2 is 7 + pad3 cycles */
+            "nop" "\n\t" /* 1 */
+            "nop" "\n\t" /* 1 */
+            "L%=b3z: "
+            "ror   %[value]" "\n\t" /* 1 */
+            ".rept %[pad4]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad4 */
+
+            "brcs  L%=b4h" "\n\t" /* 1  (not taken) */
+            "nop" "\n\t" /* 1 */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b3 is 7 + pad4 cycles */
+            "rjmp  L%=b4z" "\n\t" /* 2 */
+            "L%=b4h: " /* 2  (taken) */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b3 is 7 + pad4 cycles */
+            "nop" "\n\t" /* 1 */
+            "nop" "\n\t" /* 1 */
+            "L%=b4z: "
+            "ror   %[value]" "\n\t" /* 1 */
+            ".rept %[pad5]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad5 */
+
+            "brcs  L%=b5h" "\n\t" /* 1  (not taken) */
+            "nop" "\n\t" /* 1 */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b4 is 7 + pad5 cycles */
+            "rjmp  L%=b5z" "\n\t" /* 2 */
+            "L%=b5h: " /* 2  (taken) */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b4 is 7 + pad5 cycles */
+            "nop" "\n\t" /* 1 */
+            "nop" "\n\t" /* 1 */
+            "L%=b5z: "
+            "ror   %[value]" "\n\t" /* 1 */
+            ".rept %[pad6]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad6 */
+
+            "brcs  L%=b6h" "\n\t" /* 1  (not taken) */
+            "nop" "\n\t" /* 1 */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b5 is 7 + pad6 cycles */
+            "rjmp  L%=b6z" "\n\t" /* 2 */
+            "L%=b6h: " /* 2  (taken) */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b5 is 7 + pad6 cycles */
+            "nop" "\n\t" /* 1 */
+            "nop" "\n\t" /* 1 */
+            "L%=b6z: "
+            "ror   %[value]" "\n\t" /* 1 */
+            ".rept %[pad7]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad7 */
+
+            "brcs  L%=b7h" "\n\t" /* 1  (not taken) */
+            "nop" "\n\t" /* 1 */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b6 is 7 + pad7 cycles */
+            "rjmp  L%=b7z" "\n\t" /* 2 */
+            "L%=b7h: " /* 2  (taken) */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b6 is 7 + pad7 cycles */
+            "nop" "\n\t" /* 1 */
+            "nop" "\n\t" /* 1 */
+            "L%=b7z: "
+            "nop" "\n\t" /* 1  instead of ror */
+            ".rept %[pad8]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad8 */
+
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b7 is 5 + pad8 cycles */
+            ".rept %[padStop]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* padStop */
+            /*    <---sp is at least cycles per bit */
+
+            :
+            :
+            [value] "r" ( aValue ),
+            [txport] "I" ( TX_PORT_ADDR ),
+            [txpin] "I" ( TX_BIT_NUMBER ),
+            [pad0] "i" ( TX_UNROLLED_PADDING_NOPS(0) ),
+            [pad1] "i" ( TX_UNROLLED_PADDING_NOPS(1) ),
+            [pad2] "i" ( TX_UNROLLED_PADDING_NOPS(2) ),
+            [pad3] "i" ( TX_UNROLLED_PADDING_NOPS(3) ),
+            [pad4] "i" ( TX_UNROLLED_PADDING_NOPS(4) ),
+            [pad5] "i" ( TX_UNROLLED_PADDING_NOPS(5) ),
+            [pad6] "i" ( TX_UNROLLED_PADDING_NOPS(6) ),
+            [pad7] "i" ( TX_UNROLLED_PADDING_NOPS(7) ),
+            [pad8] "i" ( TX_UNROLLED_PADDING_NOPS(8) ),
+            [padStop] "i" ( TX_UNROLLED_STOP_PADDING_NOPS )
+    );
+    TX_STATISTICS_COUNT_FRAME
+}
+
+#  if defined(TX_USE_STREAM_KERNEL)
 /*
- * 115200 baud - 8,680 cycles per bit, 86,8 per byte at 1 MHz
- *
- *  Assembler code for 115200 baud extracted from Digispark core files:
- *  Code size is 196 byte (including first call)
- *
- *   TinySerialOut.h - Tiny write-only software serial.
- *   Copyright 2010 Rowdy Dog Software. This code is part of Arduino-Tiny.
- *
- *   Arduino-Tiny is free software: you can redistribute it and/or modify it
- *   under the terms of the GNU Lesser General Public License as published by
- *   the Free Software Foundation, either version 3 of the License, or (at your
- *   option) any later version.
+ * Streaming version of the unrolled kernel. Interrupts are disabled during each chunk of sStreamChunkLength frames.
+ * The next byte is fetched into r22 during the stop bit, Z is the pointer.
  */
-void write1Start8Data1StopNoParity(uint8_t aValue) {
+template<uint8_t tSource, bool tIsString> void writeStream(const uint8_t *aPointer, uint8_t aLength, bool aDisableInterrupts) {
+    TX_STATISTICS_STREAM_START
     asm volatile
     (
+            TX_STREAM_START_ASM
+            TX_STREAM_DICTIONARY_INIT_ASM
+            TX_STREAM_FIRST_FETCH_ASM
+
+            "L%=frame:"
             "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- 0 */
-            "ror   %[value]" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
+            "ror   r22" "\n\t" /* 1 */
+            ".rept %[pad0]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad0 */
 
             "brcs  L%=b0h" "\n\t" /* 1  (not taken) */
             "nop" "\n\t" /* 1 */
-            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- st is 9 cycles */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- st is 5 + pad0 cycles */
             "rjmp  L%=b0z" "\n\t" /* 2 */
             "L%=b0h: " /* 2  (taken) */
-            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- st is 9 cycles */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- st is 5 + pad0 cycles */
             "nop" "\n\t" /* 1 */
             "nop" "\n\t" /* 1 */
             "L%=b0z: "
-            "ror   %[value]" "\n\t" /* 1 */
-
-            "nop" "\n\t" /* 1 */
+            "ror   r22" "\n\t" /* 1 */
+            ".rept %[pad1]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad1 */
 
             "brcs  L%=b1h" "\n\t" /* 1  (not taken) */
             "nop" "\n\t" /* 1 */
-            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b0 is 8 cycles */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b0 is 7 + pad1 cycles */
             "rjmp  L%=b1z" "\n\t" /* 2 */
             "L%=b1h: " /* 2  (taken) */
-            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b0 is 8 cycles */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b0 is 7 + pad1 cycles */
             "nop" "\n\t" /* 1 */
             "nop" "\n\t" /* 1 */
             "L%=b1z: "
-            "ror   %[value]" "\n\t" /* 1 */
-
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
+            "ror   r22" "\n\t" /* 1 */
+            ".rept %[pad2]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad2 */
 
             "brcs  L%=b2h" "\n\t" /* 1  (not taken) */
             "nop" "\n\t" /* 1 */
-            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b1 is 9 cycles */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b1 is 7 + pad2 cycles */
             "rjmp  L%=b2z" "\n\t" /* 2 */
             "L%=b2h: " /* 2  (taken) */
-            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b1 is 9 cycles */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b1 is 7 + pad2 cycles */
             "nop" "\n\t" /* 1 */
             "nop" "\n\t" /* 1 */
             "L%=b2z: "
-            "ror   %[value]" "\n\t" /* 1 */
-
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
+            "ror   r22" "\n\t" /* 1 */
+            ".rept %[pad3]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad3 */
 
             "brcs  L%=b3h" "\n\t" /* 1  (not taken) */
             "nop" "\n\t" /* 1 */
-            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b2 is 9 cycles */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b2 is 7 + pad3 cycles */
             "rjmp  L%=b3z" "\n\t" /* 2 */
             "L%=b3h: " /* 2  (taken) */
-            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b2 is 9 cycles */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b2 is 7 + pad3 cycles */
             "nop" "\n\t" /* 1 */
             "nop" "\n\t" /* 1 */
             "L%=b3z: "
-            "ror   %[value]" "\n\t" /* 1 */
-
-            "nop" "\n\t" /* 1 */
+            "ror   r22" "\n\t" /* 1 */
+            ".rept %[pad4]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad4 */
 
             "brcs  L%=b4h" "\n\t" /* 1  (not taken) */
             "nop" "\n\t" /* 1 */
-            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b3 is 8 cycles */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b3 is 7 + pad4 cycles */
             "rjmp  L%=b4z" "\n\t" /* 2 */
             "L%=b4h: " /* 2  (taken) */
-            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b3 is 8 cycles */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b3 is 7 + pad4 cycles */
             "nop" "\n\t" /* 1 */
             "nop" "\n\t" /* 1 */
             "L%=b4z: "
-            "ror   %[value]" "\n\t" /* 1 */
-
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
+            "ror   r22" "\n\t" /* 1 */
+            ".rept %[pad5]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad5 */
 
             "brcs  L%=b5h" "\n\t" /* 1  (not taken) */
             "nop" "\n\t" /* 1 */
-            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b4 is 9 cycles */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b4 is 7 + pad5 cycles */
             "rjmp  L%=b5z" "\n\t" /* 2 */
             "L%=b5h: " /* 2  (taken) */
-            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b4 is 9 cycles */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b4 is 7 + pad5 cycles */
             "nop" "\n\t" /* 1 */
             "nop" "\n\t" /* 1 */
             "L%=b5z: "
-            "ror   %[value]" "\n\t" /* 1 */
-
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
+            "ror   r22" "\n\t" /* 1 */
+            ".rept %[pad6]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad6 */
 
             "brcs  L%=b6h" "\n\t" /* 1  (not taken) */
             "nop" "\n\t" /* 1 */
-            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b5 is 9 cycles */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b5 is 7 + pad6 cycles */
             "rjmp  L%=b6z" "\n\t" /* 2 */
             "L%=b6h: " /* 2  (taken) */
-            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b5 is 9 cycles */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b5 is 7 + pad6 cycles */
             "nop" "\n\t" /* 1 */
             "nop" "\n\t" /* 1 */
             "L%=b6z: "
-            "ror   %[value]" "\n\t" /* 1 */
-
-            "nop" "\n\t" /* 1 */
+            "ror   r22" "\n\t" /* 1 */
+            ".rept %[pad7]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad7 */
 
             "brcs  L%=b7h" "\n\t" /* 1  (not taken) */
             "nop" "\n\t" /* 1 */
-            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b6 is 8 cycles */
+            "cbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b6 is 7 + pad7 cycles */
             "rjmp  L%=b7z" "\n\t" /* 2 */
             "L%=b7h: " /* 2  (taken) */
-            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b6 is 8 cycles */
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b6 is 7 + pad7 cycles */
             "nop" "\n\t" /* 1 */
             "nop" "\n\t" /* 1 */
             "L%=b7z: "
-            "nop" "\n\t" /* 1 */
-
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
-
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
-            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b7 is 9 cycles */
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
-            "nop" "\n\t" /* 1 */
-            /*    <---sp is 9 cycles */
+            "nop" "\n\t" /* 1  instead of ror */
+            ".rept %[pad8]" "\n\t" "nop" "\n\t" ".endr" "\n\t" /* pad8 */
+
+            "sbi   %[txport], %[txpin]" "\n\t" /* 2  <--- b7 is 5 + pad8 cycles */
+            TX_STREAM_CHUNK_ASM
+            TX_STREAM_NEXT_ASM
+            ".rept %[gapPad]" "\n\t" "nop" "\n\t" ".endr" "\n\t"
+            "rjmp  L%=frame" "\n\t" /* 2  <--- sp is 6 + next + gapPad cycles */
+
+            TX_STREAM_INTERRUPT_WINDOW_ASM()
+
+            "L%=end:"
+            "out   __SREG__, __tmp_reg__" "\n\t"
+            "ldi   r24, lo8(%[stopCount])" "\n\t"
+            "ldi   r25, hi8(%[stopCount])" "\n\t"
+            "L%=delay:"
+            "sbiw  r24, 0x01" "\n\t"
+            "brne  L%=delay" "\n\t"
+            "L%=exit:"
 
             :
+            [pointer] "+z" ( aPointer ),
+            [length] "+r" ( aLength )
             :
-            [value] "r" ( aValue ),
-            [txport] "I" ( TX_PORT_ADDR ),
-            [txpin] "I" ( TX_BIT_NUMBER )
+            TX_STREAM_OPERANDS(tSource, tIsString),
+            [pad0] "i" ( TX_UNROLLED_PADDING_NOPS(0) ),
+            [pad1] "i" ( TX_UNROLLED_PADDING_NOPS(1) ),
+            [pad2] "i" ( TX_UNROLLED_PADDING_NOPS(2) ),
+            [pad3] "i" ( TX_UNROLLED_PADDING_NOPS(3) ),
+            [pad4] "i" ( TX_UNROLLED_PADDING_NOPS(4) ),
+            [pad5] "i" ( TX_UNROLLED_PADDING_NOPS(5) ),
+            [pad6] "i" ( TX_UNROLLED_PADDING_NOPS(6) ),
+            [pad7] "i" ( TX_UNROLLED_PADDING_NOPS(7) ),
+            [pad8] "i" ( TX_UNROLLED_PADDING_NOPS(8) ),
+            [gapPad] "i" ( TX_STREAM_PADDING_CYCLES(tSource, tIsString) )
+            :
+            "r18",
+            "r19",
+            "r20",
+            "r21",
+            "r22",
+            "r24",
+            "r25"
     );
+    TX_STATISTICS_STREAM_END
 }
+#  endif // defined(TX_USE_STREAM_KERNEL)
+
 #else
 /*
  * Small code using loop. Code size is 76 byte (including first call)
+ * All delay counts and padding nops are computed by the timing generator.
  *
  * 1 MHz CPU Clock
  *  26,04 cycles per bit, 260,4 per byte for 38400 baud at 1 MHz Clock
  *  17,36 cycles per bit, 173,6 per byte for 57600 baud at 1 MHz Clock -> therefore use 38400 baud
- *  24 cycles between each cbi/sbi (Clear/Set Bit in IO-register) command.
  *
  * 8 MHz CPU Clock
- *  69,44 cycles per bit, 694,4 per byte for 115200 baud at 8 MHz Clock
+ *  69,44 cycles per bit, 694,4 per byte for 115200 baud at 8 MHz Clock -> alternating 69 and 70 cycles
  *  34,72 cycles per bit, 347,2 per byte for 230400 baud at 8 MHz Clock.
- *  68 / 33 cycles between each cbi (Clear Bit in IO-register) or sbi command.
  *
  * 16 MHz CPU Clock
  *  138,88 cycles per bit, 1388,8 per byte for 115200 baud at 16 MHz Clock
  *  69,44 cycles per bit, 694,4 per byte for 230400 baud at 16 MHz Clock
- *  137 / 68 cycles between each cbi (Clear Bit in IO-register) or sbi command.
  *
  * 2 cycles for each cbi/sbi instruction.
  */
@@ -744,36 +3028,18 @@ void write1Start8Data1StopNoParity(uint8_t aValue) {
     asm volatile
     (
             "cbi  %[txport] , %[txpin]" "\n\t" // 2    PORTB &= ~(1 << TX_BIT_NUMBER);
-#if (F_CPU == 1000000) && !defined(_USE_115200BAUD) // 1 MHz 38400 baud
-            // 0 cycles padding to get additional 4 cycles
-            //delay4CyclesExact(5); -> 20 cycles
-            "ldi  r30 , 0x05" "\n\t"// 1
-#elif ((F_CPU == 8000000) && defined(_USE_115200BAUD)) || ((F_CPU == 16000000) && !defined(_USE_115200BAUD)) // 8 MHz 115200 baud OR 16 MHz 230400 baud
-            // 3 cycles padding to get additional 7 cycles
-            "nop" "\n\t"// 1    _nop"();
-            "nop" "\n\t"// 1    _nop"();
-            "nop" "\n\t"// 1    _nop"();
-            //delay4CyclesExact(15); -> 61 cycles
-            "ldi  r30 , 0x0F" "\n\t"// 1
-#elif (F_CPU == 8000000) && !defined(_USE_115200BAUD) // 8 MHz 230400 baud
-            // 0 cycles padding to get additional 4 cycles
-            //delay4CyclesExact(7); -> 29 cycles
-            "ldi  r30 , 0x07" "\n\t"// 1
-#elif (F_CPU == 16000000) && defined(_USE_115200BAUD) // 16 MHz 115200 baud
-            // 0 cycles padding to get additional 4 cycles
-            //delay4CyclesExact(33); -> 133 cycles
-            "ldi  r30 , 0x21" "\n\t"// 1
-#endif
-            "ldi  r31 , 0x00" "\n\t"            // 1
-            "delay1:"
+            ".rept %[startPad]" "\n\t" "nop" "\n\t" ".endr" "\n\t" // 0 to 3
+            "ldi  r30 , lo8(%[startCount])" "\n\t"// 1
+            "ldi  r31 , hi8(%[startCount])" "\n\t"// 1
+            "L%=delay1:"
             "sbiw r30 , 0x01" "\n\t"// 2
-            "brne delay1" "\n\t"// 1-2
+            "brne L%=delay1" "\n\t"// 1-2
 
             "ldi r25 , 0x08" "\n\t"// 1
 
             // Start of loop
             // if (aValue & 0x01) {
-            "txloop:"
+            "L%=txloop:"
             "sbrs %[value] , 0" "\n\t"// 1
             "rjmp .+6" "\n\t"// 2
 
@@ -786,37 +3052,20 @@ void write1Start8Data1StopNoParity(uint8_t aValue) {
             "nop" "\n\t"// 1
             "lsr %[value]" "\n\t"// 1    aValue = aValue >> 1;
 
-#if (F_CPU == 1000000) && !defined(_USE_115200BAUD) // 1 MHz 38400 baud
-            // 3 cycles padding to get additional 11 cycles
-            "nop" "\n\t"// 1
-            "nop" "\n\t"// 1
-            "nop" "\n\t"// 1
-            // delay4CyclesExact(3); -> 13 cycles
-            "ldi  r30 , 0x03" "\n\t"// 1
-#elif ((F_CPU == 8000000) && defined(_USE_115200BAUD)) || ((F_CPU == 16000000) && !defined(_USE_115200BAUD)) // 8 MHz 115200 baud OR 16 MHz 230400 baud
-            // 3 cycles padding to get additional 11 cycles
-            "nop" "\n\t"// 1
-            "nop" "\n\t"// 1
-            "nop" "\n\t"// 1
-            // delay4CyclesExact(14); -> 57 cycles
-            "ldi r30 , 0x0E" "\n\t"// 1
-#elif (F_CPU == 8000000) && !defined(_USE_115200BAUD) // 8 MHz 230400 baud
-            // 0 cycles padding to get additional 8 cycles
-            // delay4CyclesExact(6); -> 25 cycles
-            "ldi r30 , 0x05" "\n\t"// 1
-#elif (F_CPU == 16000000) && defined(_USE_115200BAUD) // 16 MHz 115200 baud
-            // 0 cycles padding to get additional 8 cycles
-            //delay4CyclesExact(32); -> 129 cycles
-            "ldi  r30 , 0x20" "\n\t"// 1
-#endif
-            "ldi r31 , 0x00" "\n\t"            // 1
-            "delay2:"
+            ".if %[alternate]" "\n\t"
+            "sbrc r25 , 0" "\n\t"// 2 for even bit counter, 1 for odd
+            "rjmp .+0" "\n\t"// 2 for odd bit counter -> 2 cycles for bit 0, 2, 4, 6 and 3 cycles for bit 1, 3, 5, 7
+            ".endif" "\n\t"
+            ".rept %[dataPad]" "\n\t" "nop" "\n\t" ".endr" "\n\t" // 0 to 3
+            "ldi r30 , lo8(%[dataCount])" "\n\t"// 1
+            "ldi r31 , hi8(%[dataCount])" "\n\t"// 1
+            "L%=delay2:"
             "sbiw r30 , 0x01" "\n\t"// 2
-            "brne delay2" "\n\t"// 1-2
+            "brne L%=delay2" "\n\t"// 1-2
 
             // }while (i > 0);
             "subi r25 , 0x01" "\n\t"// 1
-            "brne txloop" "\n\t"// 1-2
+            "brne L%=txloop" "\n\t"// 1-2
             // To compensate for missing loop cycles at last bit
             "nop" "\n\t"// 1
             "nop" "\n\t"// 1
@@ -826,39 +3075,573 @@ void write1Start8Data1StopNoParity(uint8_t aValue) {
             // Stop bit
             "sbi %[txport] , %[txpin]" "\n\t"// 2    PORTB |= 1 << TX_BIT_NUMBER;
 
-#if (F_CPU == 1000000) && !defined(_USE_115200BAUD) // 1 MHz 38400 baud
-            // delay4CyclesExact(4); -> 17 cycles - gives minimum 25 cycles for stop bit
-            "ldi  r30 , 0x04" "\n\t"// 1
-#elif ((F_CPU == 8000000) && defined(_USE_115200BAUD)) || ((F_CPU == 16000000) && !defined(_USE_115200BAUD)) // 8 MHz 115200 baud OR 16 MHz 230400 baud
-            // delay4CyclesExact(15) -> 61 cycles - gives minimum 69 cycles for stop bit
-            "ldi r30 , 0x0F" "\n\t"// 1
-#elif (F_CPU == 8000000) && !defined(_USE_115200BAUD) // 8 MHz 230400 baud
-            // delay4CyclesExact(5) -> 27 cycles - gives minimum 35 cycles for stop bit
-            "ldi r30 , 0x05" "\n\t"// 1
-#elif (F_CPU == 16000000) && defined(_USE_115200BAUD) // 16 MHz 115200 baud
-            // delay4CyclesExact(32) -> 129 cycles - gives minimum 137 cycles for stop bit
-            "ldi r30 , 0x20" "\n\t"// 1
-#endif
-            "ldi r31 , 0x00" "\n\t"            // 1
-            "delay3:"
+            "ldi r30 , lo8(%[stopCount])" "\n\t"// 1
+            "ldi r31 , hi8(%[stopCount])" "\n\t"// 1
+            "L%=delay3:"
             "sbiw r30 , 0x01" "\n\t"//
-            "brne delay3" "\n\t"// 1-2
+            "brne L%=delay3" "\n\t"// 1-2
             // return needs 4 cycles, load of next value needs 1 cycle, next rcall needs 3 cycles -> gives additional 8 cycles minimum for stop bit
 
             :
             :
             [value] "r" ( aValue ),
             [txport] "I" ( TX_PORT_ADDR ) , /* 0x18 is PORTB on Attiny 85 */
-            [txpin] "I" ( TX_BIT_NUMBER )
+            [txpin] "I" ( TX_BIT_NUMBER ),
+            [startPad] "i" ( TX_LOOP_START_PADDING_NOPS ),
+            [startCount] "i" ( TX_LOOP_START_DELAY_COUNT ),
+            [alternate] "i" ( TX_LOOP_ALTERNATE ),
+            [dataPad] "i" ( TX_LOOP_DATA_PADDING_NOPS ),
+            [dataCount] "i" ( TX_LOOP_DATA_DELAY_COUNT ),
+            [stopCount] "i" ( TX_LOOP_STOP_DELAY_COUNT )
+            :
+            "r25",
+            "r30",
+            "r31"
+    );
+    TX_STATISTICS_COUNT_FRAME
+}
+
+#  if defined(TX_USE_STREAM_KERNEL)
+/*
+ * Streaming version of the loop kernel. Interrupts are disabled during each chunk of sStreamChunkLength frames.
+ * The next byte is fetched into r22 during the stop bit, Z is the pointer, r23 is the bit counter and r24/r25 the delay counter.
+ */
+template<uint8_t tSource, bool tIsString> void writeStream(const uint8_t *aPointer, uint8_t aLength, bool aDisableInterrupts) {
+    TX_STATISTICS_STREAM_START
+    asm volatile
+    (
+            TX_STREAM_START_ASM
+            TX_STREAM_DICTIONARY_INIT_ASM
+            TX_STREAM_FIRST_FETCH_ASM
+
+            "L%=frame:"
+            "cbi  %[txport] , %[txpin]" "\n\t" // 2    PORTB &= ~(1 << TX_BIT_NUMBER);
+            ".rept %[startPad]" "\n\t" "nop" "\n\t" ".endr" "\n\t" // 0 to 3
+            "ldi  r24 , lo8(%[startCount])" "\n\t"// 1
+            "ldi  r25 , hi8(%[startCount])" "\n\t"// 1
+            "L%=delay1:"
+            "sbiw r24 , 0x01" "\n\t"// 2
+            "brne L%=delay1" "\n\t"// 1-2
+
+            "ldi r23 , 0x08" "\n\t"// 1
+
+            // Start of loop
+            "L%=txloop:"
+            "sbrs r22 , 0" "\n\t"// 1
+            "rjmp .+6" "\n\t"// 2
+
+            "nop" "\n\t"// 1
+            "sbi %[txport] , %[txpin]" "\n\t"// 2    PORTB |= 1 << TX_BIT_NUMBER;
+            "rjmp .+6" "\n\t"// 2
+
+            "cbi %[txport] , %[txpin]" "\n\t"// 2    PORTB &= ~(1 << TX_BIT_NUMBER);
+            "nop" "\n\t"// 1
+            "nop" "\n\t"// 1
+            "lsr r22" "\n\t"// 1
+
+            ".if %[alternate]" "\n\t"
+            "sbrc r23 , 0" "\n\t"// 2 for even bit counter, 1 for odd
+            "rjmp .+0" "\n\t"// 2 for odd bit counter
+            ".endif" "\n\t"
+            ".rept %[dataPad]" "\n\t" "nop" "\n\t" ".endr" "\n\t" // 0 to 3
+            "ldi r24 , lo8(%[dataCount])" "\n\t"// 1
+            "ldi r25 , hi8(%[dataCount])" "\n\t"// 1
+            "L%=delay2:"
+            "sbiw r24 , 0x01" "\n\t"// 2
+            "brne L%=delay2" "\n\t"// 1-2
+
+            "subi r23 , 0x01" "\n\t"// 1
+            "brne L%=txloop" "\n\t"// 1-2
+            // To compensate for missing loop cycles at last bit
+            "nop" "\n\t"// 1
+            "nop" "\n\t"// 1
+            "nop" "\n\t"// 1
+            "nop" "\n\t"// 1
+
+            // Stop bit
+            "sbi %[txport] , %[txpin]" "\n\t"// 2    PORTB |= 1 << TX_BIT_NUMBER;
+            TX_STREAM_CHUNK_ASM
+            TX_STREAM_NEXT_ASM
+            ".rept %[gapPad]" "\n\t" "nop" "\n\t" ".endr" "\n\t" // 0 to 3
+            ".if %[gapCount]" "\n\t"
+            "ldi r24 , lo8(%[gapCount])" "\n\t"// 1
+            "ldi r25 , hi8(%[gapCount])" "\n\t"// 1
+            "L%=delay3:"
+            "sbiw r24 , 0x01" "\n\t"// 2
+            "brne L%=delay3" "\n\t"// 1-2
+            ".endif" "\n\t"
+            "rjmp L%=frame" "\n\t"// 2
+
+            TX_STREAM_INTERRUPT_WINDOW_ASM()
+
+            "L%=end:"
+            "out   __SREG__, __tmp_reg__" "\n\t"
+            "ldi r24 , lo8(%[stopCount])" "\n\t"
+            "ldi r25 , hi8(%[stopCount])" "\n\t"
+            "L%=delay4:"
+            "sbiw r24 , 0x01" "\n\t"
+            "brne L%=delay4" "\n\t"
+            "L%=exit:"
+
+            :
+            [pointer] "+z" ( aPointer ),
+            [length] "+r" ( aLength )
+            :
+            TX_STREAM_OPERANDS(tSource, tIsString),
+            [startPad] "i" ( TX_LOOP_START_PADDING_NOPS ),
+            [startCount] "i" ( TX_LOOP_START_DELAY_COUNT ),
+            [alternate] "i" ( TX_LOOP_ALTERNATE ),
+            [dataPad] "i" ( TX_LOOP_DATA_PADDING_NOPS ),
+            [dataCount] "i" ( TX_LOOP_DATA_DELAY_COUNT ),
+            [gapPad] "i" ( TX_STREAM_DELAY_PADDING_NOPS(tSource, tIsString) ),
+            [gapCount] "i" ( TX_STREAM_DELAY_COUNT(tSource, tIsString) )
+            :
+            "r18",
+            "r19",
+            "r20",
+            "r21",
+            "r22",
+            "r23",
+            "r24",
+            "r25"
+    );
+    TX_STATISTICS_STREAM_END
+}
+#  endif // defined(TX_USE_STREAM_KERNEL)
+#endif
+
+#if defined(TINY_SERIAL_STATISTICS)
+/*
+ * Kernel cycles per byte. With TX buffer these are the cycles of the ISRs, the waiting for a free buffer entry is not counted.
+ */
+#  if defined(TINY_SERIAL_USE_TX_BUFFER)
+#define TX_STATISTICS_FRAME_CYCLES  TX_BUFFER_AWAKE_CYCLES_PER_BYTE
+#  elif defined(TINY_SERIAL_RUNTIME_BAUDRATE)
+#define TX_STATISTICS_FRAME_CYCLES  sTXStatisticsFrameCycles
+#  else
+#define TX_STATISTICS_FRAME_CYCLES  TX_FRAME_CYCLES(TINY_SERIAL_BAUDRATE)
+#  endif
+
+void countTXFrames(uint16_t aNumberOfBytes, uint16_t aNumberOfFrames) {
+    sTinySerialStatistics.BytesSent += aNumberOfBytes;
+    sTinySerialStatistics.KernelCycles += (uint32_t) aNumberOfFrames * TX_STATISTICS_FRAME_CYCLES;
+}
+
+/*
+ * Counts the interrupt lock of aNumberOfFrames sent in chunks of aFramesPerLock frames.
+ * Nothing is counted if interrupts were already disabled by the caller, or if the TX buffer is used.
+ */
+void countTXInterruptLock(uint8_t aOldSREG, uint16_t aNumberOfFrames, uint8_t aFramesPerLock) {
+#  if defined(TINY_SERIAL_USE_TX_BUFFER)
+    (void) aOldSREG;
+    (void) aNumberOfFrames;
+    (void) aFramesPerLock;
+#  else
+    if (!(aOldSREG & _BV(SREG_I)) || aNumberOfFrames == 0) {
+        return;
+    }
+    uint32_t tCycles = (uint32_t) aNumberOfFrames * TX_STATISTICS_FRAME_CYCLES;
+    sTinySerialStatistics.InterruptLockCycles += tCycles;
+    if (aNumberOfFrames > aFramesPerLock) {
+        tCycles = (uint32_t) aFramesPerLock * TX_STATISTICS_FRAME_CYCLES;
+    }
+    if (sTinySerialStatistics.MaxInterruptLockCycles < tCycles) {
+        sTinySerialStatistics.MaxInterruptLockCycles = tCycles;
+    }
+#  endif
+}
+
+#  if defined(TINY_SERIAL_COMPRESSED_STRINGS)
+/*
+ * Number of characters sent for a FC() string, i.e. with the words of the dictionary expanded
+ */
+uint16_t getCompressedStringLength(const uint8_t *aPointer) {
+    uint16_t tLength = 0;
+    uint8_t tByte = pgm_read_byte(aPointer);
+    // Comparing with 0xFF is safety net for wrong string pointer
+    while (tByte != 0 && tByte != 0xFF) {
+        if (tByte >= 0x80) {
+            const uint8_t *tWordPointer = reinterpret_cast<const uint8_t*>(pgm_read_ptr(&sTinyDictionary[tByte & 0x7F]));
+            while (pgm_read_byte(tWordPointer++) != 0) {
+                tLength++;
+            }
+        } else {
+            tLength++;
+        }
+        tByte = pgm_read_byte(++aPointer);
+    }
+    return tLength;
+}
+#  endif
+
+void resetStatistics() {
+    uint8_t tOldSREG = SREG;
+    cli();
+    memset(&sTinySerialStatistics, 0, sizeof(sTinySerialStatistics));
+    SREG = tOldSREG;
+}
+#endif // defined(TINY_SERIAL_STATISTICS)
+
+/*
+ * The energy per cycle is proportional to the supply current per MHz and VCC, and the current is roughly proportional to VCC.
+ */
+#if defined(TINY_SERIAL_USE_TX_BUFFER)
+#define TX_ENERGY_BAUDRATE  TINY_SERIAL_TX_BUFFER_BAUDRATE
+#else
+#define TX_ENERGY_BAUDRATE  TINY_SERIAL_BAUDRATE
+#endif
+#define TX_ENERGY_CYCLES_PER_BYTE   ((10 * F_CPU + (TX_ENERGY_BAUDRATE / 2)) / TX_ENERGY_BAUDRATE)
+
+uint32_t scaleTXEnergyToVCC(uint32_t aPicojouleAt3Volt, uint16_t aVCCMillivolt) {
+    uint16_t tVCC = aVCCMillivolt / 10; // avoid overflow
+    return ((aPicojouleAt3Volt / 100) * tVCC / 300 * tVCC) / 3000;
+}
+
+uint32_t getBusyWaitTXEnergyPerByteNanojoule(uint16_t aVCCMillivolt) {
+    return scaleTXEnergyToVCC(TX_ENERGY_CYCLES_PER_BYTE * TINY_SERIAL_ACTIVE_PICOJOULE_PER_CYCLE, aVCCMillivolt);
+}
+
+uint32_t getTXEnergyPerByteNanojoule(uint16_t aVCCMillivolt) {
+#if defined(TINY_SERIAL_SLEEP_WHILE_WAITING)
+#  if TX_BUFFER_AWAKE_CYCLES_PER_BYTE < TX_ENERGY_CYCLES_PER_BYTE
+    return scaleTXEnergyToVCC(
+            TX_BUFFER_AWAKE_CYCLES_PER_BYTE * TINY_SERIAL_ACTIVE_PICOJOULE_PER_CYCLE
+                    + (TX_ENERGY_CYCLES_PER_BYTE - TX_BUFFER_AWAKE_CYCLES_PER_BYTE) * TINY_SERIAL_IDLE_PICOJOULE_PER_CYCLE, aVCCMillivolt);
+#  else
+    return getBusyWaitTXEnergyPerByteNanojoule(aVCCMillivolt); // The ISR leaves no time to sleep
+#  endif
+#else
+    return getBusyWaitTXEnergyPerByteNanojoule(aVCCMillivolt);
+#endif
+}
+
+#if !defined(TINY_SERIAL_HOST_TX)
+/*
+ * OSCCAL calibration
+ */
+#if defined(WDTCSR)
+#define TX_WATCHDOG_REGISTER    WDTCSR
+#else
+#define TX_WATCHDOG_REGISTER    WDTCR
+#endif
+#if defined(WDTIF) // ATtiny13
+#define TX_WATCHDOG_FLAG_BIT    WDTIF
+#define TX_WATCHDOG_ENABLE_BIT  WDTIE
+#else
+#define TX_WATCHDOG_FLAG_BIT    WDIF
+#define TX_WATCHDOG_ENABLE_BIT  WDIE
+#endif
+
+/*
+ * Increments aCount every 6 cycles, until the bit of the I/O register has the value tLevel
+ */
+template<uint8_t tIOAddress, uint8_t tBitNumber, bool tLevel> inline void countLoopsUntilLevel(uint16_t &aCount) {
+    asm volatile
+    (
+            "L%=loop:"
+            "adiw %[count] , 1" "\n\t" // 2
+            "in __tmp_reg__ , %[ioAddress]" "\n\t" // 1
+            ".if %[level]" "\n\t"
+            "sbrs __tmp_reg__ , %[bit]" "\n\t" // 1
+            ".else" "\n\t"
+            "sbrc __tmp_reg__ , %[bit]" "\n\t" // 1
+            ".endif" "\n\t"
+            "rjmp L%=loop" "\n\t" // 2
+            : [count] "+w" ( aCount )
+            : [ioAddress] "I" ( tIOAddress ),
+            [bit] "I" ( tBitNumber ),
+            [level] "i" ( tLevel )
+    );
+}
+
+uint16_t measureCalibrationReference() {
+    uint16_t tCount = 0;
+    uint8_t tOldSREG = SREG;
+    cli();
+#if defined(TINY_SERIAL_CALIBRATION_PIN)
+    // Synchronize to a rising edge
+    countLoopsUntilLevel<TX_PORT_ADDR - 2, TINY_SERIAL_CALIBRATION_PIN, false>(tCount);
+    countLoopsUntilLevel<TX_PORT_ADDR - 2, TINY_SERIAL_CALIBRATION_PIN, true>(tCount);
+    tCount = 0;
+    uint8_t tPeriods = 0; // 256 periods
+    // The 2 loop exits take 5 cycles each, so the end of each period is padded to 18 cycles for 3 counts
+    asm volatile
+    (
+            "L%=low:"
+            "adiw %[count] , 1" "\n\t" // 2
+            "in __tmp_reg__ , %[ioAddress]" "\n\t" // 1
+            "sbrc __tmp_reg__ , %[bit]" "\n\t" // 1 / 2
+            "rjmp L%=low" "\n\t" // 2
+
+            "L%=high:"
+            "adiw %[count] , 1" "\n\t" // 2
+            "in __tmp_reg__ , %[ioAddress]" "\n\t" // 1
+            "sbrs __tmp_reg__ , %[bit]" "\n\t" // 1 / 2
+            "rjmp L%=high" "\n\t" // 2
+
+            "adiw %[count] , 1" "\n\t" // 2
+            "nop" "\n\t" // 1
+            "nop" "\n\t" // 1
+            "nop" "\n\t" // 1
+            "dec %[periods]" "\n\t" // 1
+            "brne L%=low" "\n\t" // 2
+            : [count] "+w" ( tCount ), [periods] "+r" ( tPeriods )
+            : [ioAddress] "I" ( TX_PORT_ADDR - 2 ),
+            [bit] "I" ( TINY_SERIAL_CALIBRATION_PIN )
+    );
+#else
+    // Watchdog in interrupt mode with 16 ms, the flag is polled, since interrupts are disabled
+    uint8_t tOldWatchdog = TX_WATCHDOG_REGISTER;
+    MCUSR &= ~_BV(WDRF); // WDRF forces WDE, which would reset at the second timeout
+    asm volatile("wdr");
+    TX_WATCHDOG_REGISTER = _BV(WDCE) | _BV(WDE);
+    TX_WATCHDOG_REGISTER = _BV(TX_WATCHDOG_FLAG_BIT) | _BV(TX_WATCHDOG_ENABLE_BIT);
+    // The first period is not synchronized to the watchdog oscillator, so count the second one
+    countLoopsUntilLevel<_SFR_IO_ADDR(TX_WATCHDOG_REGISTER), TX_WATCHDOG_FLAG_BIT, true>(tCount);
+    TX_WATCHDOG_REGISTER = _BV(TX_WATCHDOG_FLAG_BIT) | _BV(TX_WATCHDOG_ENABLE_BIT); // reset flag by writing 1
+    tCount = 0;
+    countLoopsUntilLevel<_SFR_IO_ADDR(TX_WATCHDOG_REGISTER), TX_WATCHDOG_FLAG_BIT, true>(tCount);
+    // Restore old settings, the flag is cleared to avoid an interrupt of the old settings
+    asm volatile("wdr");
+    TX_WATCHDOG_REGISTER = _BV(WDCE) | _BV(WDE);
+    TX_WATCHDOG_REGISTER = tOldWatchdog | _BV(TX_WATCHDOG_FLAG_BIT);
+#endif
+    SREG = tOldSREG;
+    return tCount;
+}
+
+/*
+ * OSCCAL is changed in steps of 1, since the datasheet does not allow more than 2% change at once.
+ * Stops if the error is below 0.4% or changes its sign, and keeps the better value. The range bit 7 of OSCCAL is never changed.
+ */
+bool calibrateOSCCAL(uint16_t aReferenceCount) {
+    int16_t tError = measureCalibrationReference() - aReferenceCount; // positive if CPU clock is too fast
+    for (uint8_t i = 0; i < 0x7F; i++) {
+        if ((uint16_t) abs(tError) <= aReferenceCount / 256) {
+            break;
+        }
+        uint8_t tOldOSCCAL = OSCCAL;
+        uint8_t tNewOSCCAL = tOldOSCCAL;
+        if (tError > 0) {
+            if ((tOldOSCCAL & 0x7F) == 0) {
+                break;
+            }
+            tNewOSCCAL--;
+        } else {
+            if ((tOldOSCCAL & 0x7F) == 0x7F) {
+                break;
+            }
+            tNewOSCCAL++;
+        }
+        OSCCAL = tNewOSCCAL;
+        int16_t tNewError = measureCalibrationReference() - aReferenceCount;
+        if ((tNewError ^ tError) < 0) {
+            // sign changed, the best value is one of the last two
+            if (abs(tNewError) > abs(tError)) {
+                OSCCAL = tOldOSCCAL;
+            } else {
+                tError = tNewError;
+            }
+            break;
+        }
+        tError = tNewError;
+    }
+    return (uint16_t) abs(tError) < aReferenceCount / 50;
+}
+#endif // !defined(TINY_SERIAL_HOST_TX)
+
+/***********************************************************
+ * The TinySerialOutT class functions for additional channels
+ ***********************************************************/
+/*
+ * The default channel uses the kernel and the write functions of Serial, so it adds no code.
+ * This is only possible for the compile time kernels, the TX buffer and the runtime kernel may use another baud rate.
+ */
+#if defined(TX_USE_COMPILE_TIME_KERNEL)
+#define TX_IS_DEFAULT_CHANNEL(aPortAddress, aBitNumber, aBaudrate) \
+    ((aPortAddress) == TX_PORT_ADDR && (aBitNumber) == TX_BIT_NUMBER && (aBaudrate) == TINY_SERIAL_BAUDRATE)
+#else
+#define TX_IS_DEFAULT_CHANNEL(aPortAddress, aBitNumber, aBaudrate) false
+#endif
+
+template<uint8_t tPortAddress, uint8_t tBitNumber, uint32_t tBaudrate>
+void TinySerialOutT<tPortAddress, tBitNumber, tBaudrate>::begin() {
+    // TX pin is active LOW, so set it to HIGH initially. DDRx is always at PORTx - 1.
+    _SFR_IO8(tPortAddress) |= (1 << tBitNumber);
+    _SFR_IO8(tPortAddress - 1) |= (1 << tBitNumber);
+}
+
+/*
+ * Same loop kernel as write1Start8Data1StopNoParity(), but port, pin and delay counts are taken from the template parameters.
+ * Interrupts are disabled during the frame.
+ */
+template<uint8_t tPortAddress, uint8_t tBitNumber, uint32_t tBaudrate>
+void TinySerialOutT<tPortAddress, tBitNumber, tBaudrate>::write(uint8_t aByte) {
+    static_assert(tPortAddress < 0x20 && tBitNumber < 8, "TinySerialOutT: port must be an I/O address below 0x20 for sbi/cbi, e.g. 0x18 for PORTB");
+    static_assert(TX_IS_DEFAULT_CHANNEL(tPortAddress, tBitNumber, tBaudrate) || TX_CYCLES_X256(tBaudrate) >= (20 * 256),
+            "TinySerialOutT: baud rate is too high for F_CPU, the loop kernel requires at least 20 cycles per bit");
+    static_assert(TX_IS_DEFAULT_CHANNEL(tPortAddress, tBitNumber, tBaudrate) || (((TX_CYCLES_X256(tBaudrate) + 255) >> 8) - 11 + 3) / 4 <= 0xFFFF,
+            "TinySerialOutT: baud rate is too low for F_CPU");
+
+    if (TX_IS_DEFAULT_CHANNEL(tPortAddress, tBitNumber, tBaudrate)) {
+        write1Start8Data1StopNoParityWithCliSei(aByte);
+        return;
+    }
+#if defined(TINY_SERIAL_HOST_TX)
+    writeHostTXFrame(aByte, TX_FRAME_CYCLES(tBaudrate));
+#else
+    uint8_t tOldSREG = SREG;
+    cli();
+    asm volatile
+    (
+            "cbi  %[txport] , %[txpin]" "\n\t" // 2
+            ".rept %[startPad]" "\n\t" "nop" "\n\t" ".endr" "\n\t" // 0 to 3
+            "ldi  r30 , lo8(%[startCount])" "\n\t"// 1
+            "ldi  r31 , hi8(%[startCount])" "\n\t"// 1
+            "L%=delay1:"
+            "sbiw r30 , 0x01" "\n\t"// 2
+            "brne L%=delay1" "\n\t"// 1-2
+
+            "ldi r25 , 0x08" "\n\t"// 1
+
+            "L%=txloop:"
+            "sbrs %[value] , 0" "\n\t"// 1
+            "rjmp .+6" "\n\t"// 2
+
+            "nop" "\n\t"// 1
+            "sbi %[txport] , %[txpin]" "\n\t"// 2
+            "rjmp .+6" "\n\t"// 2
+
+            "cbi %[txport] , %[txpin]" "\n\t"// 2
+            "nop" "\n\t"// 1
+            "nop" "\n\t"// 1
+            "lsr %[value]" "\n\t"// 1
+
+            ".if %[alternate]" "\n\t"
+            "sbrc r25 , 0" "\n\t"// 2 for even bit counter, 1 for odd
+            "rjmp .+0" "\n\t"// 2 for odd bit counter
+            ".endif" "\n\t"
+            ".rept %[dataPad]" "\n\t" "nop" "\n\t" ".endr" "\n\t" // 0 to 3
+            "ldi r30 , lo8(%[dataCount])" "\n\t"// 1
+            "ldi r31 , hi8(%[dataCount])" "\n\t"// 1
+            "L%=delay2:"
+            "sbiw r30 , 0x01" "\n\t"// 2
+            "brne L%=delay2" "\n\t"// 1-2
+
+            "subi r25 , 0x01" "\n\t"// 1
+            "brne L%=txloop" "\n\t"// 1-2
+            // To compensate for missing loop cycles at last bit
+            "nop" "\n\t"// 1
+            "nop" "\n\t"// 1
+            "nop" "\n\t"// 1
+            "nop" "\n\t"// 1
+
+            // Stop bit, restoring SREG, ret and the next call add at least 11 cycles
+            "sbi %[txport] , %[txpin]" "\n\t"// 2
+
+            "ldi r30 , lo8(%[stopCount])" "\n\t"// 1
+            "ldi r31 , hi8(%[stopCount])" "\n\t"// 1
+            "L%=delay3:"
+            "sbiw r30 , 0x01" "\n\t"//
+            "brne L%=delay3" "\n\t"// 1-2
+
+            : [value] "+r" ( aByte )
+            :
+            [txport] "I" ( tPortAddress ),
+            [txpin] "I" ( tBitNumber ),
+            [startPad] "i" ( (TX_START_CYCLES(tBaudrate) - 7) % 4 ),
+            [startCount] "i" ( (TX_START_CYCLES(tBaudrate) - 7) / 4 ),
+            [alternate] "i" ( TX_ALTERNATE(tBaudrate) ),
+            [dataPad] "i" ( (TX_DATA_CYCLES(tBaudrate) - (TX_ALTERNATE(tBaudrate) ? 14 : 12)) % 4 ),
+            [dataCount] "i" ( (TX_DATA_CYCLES(tBaudrate) - (TX_ALTERNATE(tBaudrate) ? 14 : 12)) / 4 ),
+            [stopCount] "i" ( (((TX_CYCLES_X256(tBaudrate) + 255) >> 8) - 11 + 3) / 4 )
             :
             "r25",
             "r30",
             "r31"
     );
+    SREG = tOldSREG;
+#endif
+}
+
+template<uint8_t tPortAddress, uint8_t tBitNumber, uint32_t tBaudrate>
+void TinySerialOutT<tPortAddress, tBitNumber, tBaudrate>::print(const char *aStringPtr) {
+    if (TX_IS_DEFAULT_CHANNEL(tPortAddress, tBitNumber, tBaudrate)) {
+        writeString(aStringPtr);
+    } else {
+        while (*aStringPtr != 0) {
+            write(*aStringPtr++);
+        }
+    }
+}
+
+template<uint8_t tPortAddress, uint8_t tBitNumber, uint32_t tBaudrate>
+void TinySerialOutT<tPortAddress, tBitNumber, tBaudrate>::print(const __FlashStringHelper *aStringPtr) {
+    if (TX_IS_DEFAULT_CHANNEL(tPortAddress, tBitNumber, tBaudrate)) {
+        writeString(aStringPtr);
+    } else {
+        PGM_P tPGMStringPtr = reinterpret_cast<PGM_P>(aStringPtr);
+        uint8_t tChar = pgm_read_byte((const uint8_t * ) tPGMStringPtr);
+        while (tChar != 0) {
+            write(tChar);
+            tChar = pgm_read_byte((const uint8_t * ) ++tPGMStringPtr);
+        }
+    }
+}
 
+#if defined(TINY_SERIAL_COMPRESSED_STRINGS)
+template<uint8_t tPortAddress, uint8_t tBitNumber, uint32_t tBaudrate>
+void TinySerialOutT<tPortAddress, tBitNumber, tBaudrate>::print(const TinyCompressedStringHelper *aStringPtr) {
+    if (TX_IS_DEFAULT_CHANNEL(tPortAddress, tBitNumber, tBaudrate)) {
+        writeString(aStringPtr);
+    } else {
+        PGM_P tPGMStringPtr = reinterpret_cast<PGM_P>(aStringPtr);
+        uint8_t tChar = pgm_read_byte((const uint8_t * ) tPGMStringPtr);
+        while (tChar != 0) {
+            if (tChar >= 0x80) {
+                // token, words of the dictionary contain no tokens
+                print(reinterpret_cast<const __FlashStringHelper *>(pgm_read_ptr(&sTinyDictionary[tChar & 0x7F])));
+            } else {
+                write(tChar);
+            }
+            tChar = pgm_read_byte((const uint8_t * ) ++tPGMStringPtr);
+        }
+    }
 }
 #endif
 
+/*
+ * Other channels use ultoa() and the string output, to avoid a copy of the digit engine for each channel
+ */
+template<uint8_t tPortAddress, uint8_t tBitNumber, uint32_t tBaudrate>
+void TinySerialOutT<tPortAddress, tBitNumber, tBaudrate>::print(uint32_t aLong, uint8_t aBase) {
+    if (TX_IS_DEFAULT_CHANNEL(tPortAddress, tBitNumber, tBaudrate)) {
+        writeUnsignedWithBase(aLong, aBase);
+    } else {
+        char tStringBuffer[33];
+        ultoa(aLong, tStringBuffer, aBase);
+        print(tStringBuffer);
+    }
+}
+
+template<uint8_t tPortAddress, uint8_t tBitNumber, uint32_t tBaudrate>
+void TinySerialOutT<tPortAddress, tBitNumber, tBaudrate>::print(int32_t aLong, uint8_t aBase) {
+    uint32_t tValue = aLong;
+    if (aBase == 10 && aLong < 0) {
+        write('-');
+        tValue = -tValue;
+    }
+    // like ltoa(), other bases print the two's complement
+    print(tValue, aBase);
+}
+
+template<uint8_t tPortAddress, uint8_t tBitNumber, uint32_t tBaudrate>
+void TinySerialOutT<tPortAddress, tBitNumber, tBaudrate>::println() {
+    write('\r');
+    write('\n');
+}
+
+#if !defined(TINY_SERIAL_HOST_TX)
 /*
  * C Version which generates the assembler code above.
  *      In order to guarantee the correct timing, compile with Arduino standard settings or:
@@ -910,6 +3693,7 @@ void write1Start8Data1StopNoParity_C_Version(uint8_t aValue) {
 // -8 cycles to compensate for fastest repeated call (1 ret + 1 load + 1 call)
     delay4CyclesExact(4); // gives minimum 25 cycles for stop bit :-)
 }
+#endif
 #elif defined(ARDUINO_ARCH_APOLLO3)
     void AttinySerialOutDummyToAvoidBFDAssertions(){
         ;
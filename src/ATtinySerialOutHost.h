@@ -0,0 +1,110 @@
+/*
+ * ATtinySerialOutHost.h
+ *
+ * Replacements for the AVR and Arduino definitions used by ATtinySerialOut, if compiled for the host with TINY_SERIAL_HOST_TX.
+ * The I/O registers are an array in RAM with the addresses of the ATtiny85, PROGMEM and EEMEM data are plain RAM data.
+ * Included by ATtinySerialOut.h instead of Arduino.h.
+ *
+ *  Copyright (C) 2024  Armin Joachimsmeyer
+ *  Email: armin.joachimsmeyer@gmail.com
+ *
+ *  This file is part of TinySerialOut https://github.com/ArminJo/ATtinySerialOut.
+ *
+ *  TinySerialOut is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program. If not, see <http://www.gnu.org/licenses/gpl.html>.
+ *
+ */
+#ifndef _ATTINY_SERIAL_OUT_HOST_H
+#define _ATTINY_SERIAL_OUT_HOST_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(F_CPU)
+#define F_CPU 8000000UL
+#endif
+
+/*
+ * I/O registers, defined in ATtinySerialOut.hpp
+ */
+extern uint8_t sHostIORegisters[0x40];
+#define _SFR_IO8(aIOAddress)        sHostIORegisters[aIOAddress]
+#define _SFR_IO_ADDR(aRegister)     ((uint8_t) (&(aRegister) - sHostIORegisters))
+#define _BV(aBit)                   (1 << (aBit))
+#define SREG_I                      7
+
+#define SREG    _SFR_IO8(0x3F)
+#define PORTB   _SFR_IO8(0x18)
+#define DDRB    _SFR_IO8(0x17)
+#define PINB    _SFR_IO8(0x16)
+
+#define PB0     0
+#define PB1     1
+#define PB2     2
+#define PB3     3
+#define PB4     4
+#define PB5     5
+#define PIN_PB0 0
+#define PIN_PB1 1
+#define PIN_PB2 2
+#define PIN_PB3 3
+#define PIN_PB4 4
+#define PIN_PB5 5
+
+// Only the I bit of SREG, so SREG = tOldSREG restores the interrupt state like on the AVR
+#define cli()   (SREG &= ~0x80)
+#define sei()   (SREG |= 0x80)
+
+/*
+ * Program memory and EEPROM
+ */
+#define PROGMEM
+#define EEMEM
+#define PGM_P                       const char *
+#define PSTR(aString)               (aString)
+#define pgm_read_byte(aAddress)     (*(const uint8_t *) (aAddress))
+#define pgm_read_word(aAddress)     (*(const uint16_t *) (aAddress))
+#define pgm_read_dword(aAddress)    (*(const uint32_t *) (aAddress))
+#define pgm_read_ptr(aAddress)      (*(const void * const *) (aAddress))
+#define memcpy_P                    memcpy
+#define eeprom_read_byte(aAddress)  (*(const uint8_t *) (aAddress))
+#define eeprom_busy_wait()
+
+/*
+ * Same as ultoa() of avr-libc, an invalid radix gives an empty string.
+ * Writes without bounds check, so a too small buffer is detected by -fsanitize=address.
+ */
+inline char* ultoa(unsigned long aValue, char *aBuffer, int aRadix) {
+    char *tPointer = aBuffer;
+    if (aRadix >= 2 && aRadix <= 36) {
+        aValue = (uint32_t) aValue;
+        do {
+            uint8_t tDigit = aValue % aRadix;
+            *tPointer++ = (tDigit < 10) ? tDigit + '0' : tDigit + 'a' - 10;
+            aValue /= aRadix;
+        } while (aValue != 0);
+    }
+    *tPointer = '\0';
+    // reverse the digits
+    for (char *tStart = aBuffer, *tEnd = tPointer - 1; tStart < tEnd; tStart++, tEnd--) {
+        char tChar = *tStart;
+        *tStart = *tEnd;
+        *tEnd = tChar;
+    }
+    return aBuffer;
+}
+
+#endif // _ATTINY_SERIAL_OUT_HOST_H